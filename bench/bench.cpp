@@ -0,0 +1,330 @@
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "constants.h"
+#include "http/field_value.h"
+#include "http/headers.h"
+#include "http/request_parser.h"
+#include "http/response.h"
+#include "load_generator.h"
+#include "memory/arena.h"
+#include "memory/buffer.h"
+#include "metrics/histogram.h"
+#include "net/server.h"
+#include "utils/utils.h"
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    constexpr std::size_t kBatch = 256; // Operations timed together, one clock read is ~20ns
+
+    constexpr std::string_view kRequest =
+        "GET /api/v1/items?page=2&sort=name HTTP/1.1\r\n"
+        "Host: bench.example.com\r\n"
+        "User-Agent: Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36 (KHTML, like Gecko) Chrome/120.0 Safari/537.36\r\n"
+        "Accept: text/html,application/xhtml+xml,application/xml;q=0.9,image/avif,image/webp,*/*;q=0.8\r\n"
+        "Accept-Language: en-US,en;q=0.9\r\n"
+        "Accept-Encoding: gzip, deflate, br\r\n"
+        "Cache-Control: max-age=0\r\n"
+        "Cookie: session=4f1c2d9e8b7a6f5e4d3c2b1a; theme=dark\r\n"
+        "Referer: https://bench.example.com/items\r\n"
+        "If-None-Match: \"5e4d3c-2b1a\"\r\n"
+        "X-Request-Id: 0f8c7b6a-5d4e-3f2a-1b0c-9d8e7f6a5b4c\r\n"
+        "Connection: keep-alive\r\n"
+        "\r\n";
+
+    struct Options {
+        std::string filter;          //!< Only run benchmarks whose name contains this
+        double seconds {0.5};        //!< Length of each micro benchmark
+        bool json {false};
+        std::size_t reactors {0};    //!< End-to-end server threads, 0 uses every hardware thread
+        bool instrumented {false};   //!< End-to-end server records metrics and sends server-timing
+        bench::LoadOptions load;
+    };
+
+    struct Report {
+        std::string name;
+        double rate {0.0};           //!< Operations per second
+        double scale {1.0};          //!< Histogram units per nanosecond
+        std::size_t batch {1};       //!< Operations per sample, above 1 samples are batch means
+        metrics::Histogram histogram;
+        uint64_t errors {0};
+
+        double nanoseconds(const uint64_t value) const {
+            return static_cast<double>(value) / scale;
+        }
+    };
+
+    //! Keeps the compiler from discarding a result that is only computed to be timed
+    template <typename T>
+    void keep(const T& value) {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+    /**
+     * Runs operation for about seconds in batches of kBatch calls and records the mean time
+     * per call of every batch, in picoseconds so that operations of a few nanoseconds keep
+     * their precision. A single call is too short for the clock; batch means still show the
+     * tail caused by cache misses, page faults and preemption.
+     */
+    template <typename Operation>
+    Report measure(std::string name, const double seconds, Operation&& operation) {
+        Report report;
+        report.name  = std::move(name);
+        report.scale = 1000.0;
+        report.batch = kBatch;
+
+        std::size_t counter = 0;
+        for (std::size_t i = 0; i < 16 * kBatch; ++i) operation(counter++); // Warm up caches and predictors
+
+        const Clock::time_point start    = Clock::now();
+        const Clock::time_point deadline = start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(seconds));
+        Clock::time_point now            = start;
+        uint64_t operations              = 0;
+        while (now < deadline) {
+            const Clock::time_point before = now;
+            for (std::size_t i = 0; i < kBatch; ++i) operation(counter++);
+            now = Clock::now();
+
+            const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(now - before).count();
+            report.histogram.record(static_cast<uint64_t>(elapsed) * 1000 / kBatch);
+            operations += kBatch;
+        }
+        report.rate = static_cast<double>(operations) / std::chrono::duration<double>(now - start).count();
+        return report;
+    }
+
+    std::vector<std::string> headerNames() {
+        std::vector<std::string> names;
+        for (std::size_t i = 0; i < http::headers::kCount; ++i) {
+            const std::string_view name = http::headers::name(static_cast<http::headers::Id>(i));
+            names.emplace_back(name);
+
+            // Clients send canonical capitalisation, lookups must not care
+            std::string canonical(name);
+            for (std::size_t c = 0; c < canonical.size(); ++c) {
+                if (c == 0 || canonical[c - 1] == '-') canonical[c] = static_cast<char>(canonical[c] - ('a' <= canonical[c] && canonical[c] <= 'z' ? 32 : 0));
+            }
+            names.push_back(std::move(canonical));
+        }
+        for (const char* unknown : {"x-request-id", "x-forwarded-proto", "x-powered-by", "cf-ray"}) names.emplace_back(unknown);
+        return names;
+    }
+
+    void hello(const http::Request&, http::Response& response) {
+        response.set(http::headers::body_information::content_type, "text/plain");
+        response.body.assign("Hello from sagan\n");
+    }
+
+    std::vector<Report> runMicro(const Options& options) {
+        std::vector<Report> reports;
+        const auto selected = [&](const std::string_view name) {
+            return options.filter.empty() || name.find(options.filter) != std::string_view::npos;
+        };
+
+        const std::vector<std::string> names = headerNames();
+        if (selected("headers.lookup")) {
+            reports.push_back(measure("headers.lookup", options.seconds, [&](const std::size_t i) {
+                keep(http::headers::lookup(names[i % names.size()]));
+            }));
+        }
+        if (selected("headers.linear_scan")) {
+            // What a lookup costs without the perfect hash, for reference
+            reports.push_back(measure("headers.linear_scan", options.seconds, [&](const std::size_t i) {
+                const std::string_view name = names[i % names.size()];
+                std::size_t id              = 0;
+                while (id < http::headers::kCount && !http::equalsIgnoreCase(http::headers::name(static_cast<http::headers::Id>(id)), name)) ++id;
+                keep(id);
+            }));
+        }
+
+        if (selected("parser.request")) {
+            http::RequestParser parser;
+            http::Request request;
+            reports.push_back(measure("parser.request", options.seconds, [&](std::size_t) {
+                parser.reset();
+                keep(parser.parse(kRequest, request));
+            }));
+        }
+
+        if (selected("utils.format_field")) {
+            char line[64];
+            reports.push_back(measure("utils.format_field", options.seconds, [&](const std::size_t i) {
+                keep(Utils::format(line, http::headers::body_information::content_length, ": ", i, "\r\n").size());
+            }));
+        }
+
+        int values[32];
+        for (int i = 0; i < 32; ++i) values[i] = i * 7919 - 65536;
+        if (selected("utils.join_array")) {
+            char line[Utils::kMaxFormattedSize<decltype(Utils::join(values))> + 2];
+            reports.push_back(measure("utils.join_array", options.seconds, [&](const std::size_t i) {
+                values[i % 32] ^= 1;
+                keep(Utils::format(line, '[', Utils::join(values), ']').size());
+            }));
+        }
+        if (selected("ostream.join_array")) {
+            // The iostream formatting the utils layer replaced, for reference
+            std::ostringstream stream;
+            reports.push_back(measure("ostream.join_array", options.seconds, [&](const std::size_t i) {
+                values[i % 32] ^= 1;
+                stream.str(std::string());
+                stream << '[';
+                for (int v = 0; v < 32; ++v) stream << values[v] << (v != 31 ? ", " : "");
+                stream << ']';
+                keep(stream.tellp());
+            }));
+        }
+
+        if (selected("http.serialize")) {
+            memory::Arena arena;
+            memory::Buffer out;
+            http::Framing framing;
+            framing.date = "Sun, 06 Nov 1994 08:49:37 GMT";
+            reports.push_back(measure("http.serialize", options.seconds, [&](std::size_t) {
+                {
+                    http::Response response(arena);
+                    response.set(http::headers::body_information::content_type, "application/json");
+                    response.set(http::headers::caching::cache_control, "public, max-age=60");
+                    response.set(http::headers::conditionals::etag, "\"5e4d3c-2b1a\"");
+                    response.body.assign("{\"status\":\"ok\"}");
+                    http::serialize(response, framing, out);
+                }
+                keep(out.size());
+                out.clear();
+                arena.reset();
+            }));
+        }
+        return reports;
+    }
+
+    Report runLoopback(const Options& options) {
+        net::Config config;
+        config.port    = 0;
+        config.threads = options.reactors;
+        if (options.instrumented) {
+            config.metrics_path  = "/metrics";
+            config.server_timing = true;
+        }
+
+        net::Server server(config, hello);
+        server.start();
+        bench::LoadOptions load = options.load;
+        load.port               = server.port();
+        bench::LoadResult result = bench::runLoad(load);
+        server.stop();
+        server.join();
+
+        Report report;
+        report.name      = "e2e.loopback";
+        report.rate      = result.rate();
+        report.histogram = result.latency;
+        report.errors    = result.errors;
+        return report;
+    }
+
+    void printTable(const std::vector<Report>& reports) {
+        std::printf("%-22s %14s %6s %12s %12s %12s %12s %8s\n", "benchmark", "ops/s", "batch", "mean ns", "p50 ns", "p99 ns",
+                    "p99.9 ns", "errors");
+        bool batched = false;
+        for (const Report& report : reports) {
+            const metrics::Histogram& histogram = report.histogram;
+            std::printf("%-22s %14.0f %6zu %12.2f %12.2f %12.2f %12.2f %8llu\n", report.name.c_str(), report.rate, report.batch,
+                        histogram.mean() / report.scale, report.nanoseconds(histogram.percentile(0.5)),
+                        report.nanoseconds(histogram.percentile(0.99)), report.nanoseconds(histogram.percentile(0.999)),
+                        static_cast<unsigned long long>(report.errors));
+            batched = batched || report.batch > 1;
+        }
+        if (batched) std::printf("Percentiles of rows with a batch above 1 are of the mean time per operation of each batch\n");
+    }
+
+    void printJson(const std::vector<Report>& reports, const Options& options) {
+        std::printf("{\n  \"config\": {\"seconds\": %.3f, \"reactors\": %zu, \"instrumented\": %s, \"client_threads\": %zu, "
+                    "\"connections\": %zu, \"pipeline\": %zu, \"load_seconds\": %.3f},\n  \"benchmarks\": [\n",
+                    options.seconds, options.reactors, options.instrumented ? "true" : "false", options.load.threads, options.load.connections,
+                    options.load.pipeline, options.load.seconds);
+        for (std::size_t i = 0; i < reports.size(); ++i) {
+            const Report& report                = reports[i];
+            const metrics::Histogram& histogram = report.histogram;
+            // Percentiles of batch means are not percentiles of single operations, name them apart
+            const char* prefix = report.batch > 1 ? "batch_mean_" : "";
+            std::printf("    {\"name\": \"%s\", \"ops_per_second\": %.1f, \"batch\": %zu, \"samples\": %llu, \"mean_ns\": %.3f, "
+                        "\"%sp50_ns\": %.3f, \"%sp99_ns\": %.3f, \"%sp999_ns\": %.3f, \"%smax_ns\": %.3f, \"errors\": %llu}%s\n",
+                        report.name.c_str(), report.rate, report.batch, static_cast<unsigned long long>(histogram.count()),
+                        histogram.mean() / report.scale, prefix, report.nanoseconds(histogram.percentile(0.5)), prefix,
+                        report.nanoseconds(histogram.percentile(0.99)), prefix, report.nanoseconds(histogram.percentile(0.999)),
+                        prefix, report.nanoseconds(histogram.max()), static_cast<unsigned long long>(report.errors),
+                        i + 1 < reports.size() ? "," : "");
+        }
+        std::printf("  ]\n}\n");
+    }
+
+    void usage(const char* program) {
+        std::fprintf(stderr,
+                     "Usage: %s [-f filter] [-s seconds] [-j] [-m] [-t reactors] [-C client threads] [-c connections]\n"
+                     "          [-p pipeline depth] [-d load seconds]\n"
+                     "  -f    Only run benchmarks whose name contains filter\n"
+                     "  -s    Length of each micro benchmark (default 0.5)\n"
+                     "  -j    Print JSON instead of a table\n"
+                     "  -m    Record metrics and send server-timing in the loopback test\n"
+                     "  -t    Server reactors of the loopback test, 0 uses every hardware thread (default 0)\n"
+                     "  -C    Load generator threads (default: hardware threads)\n"
+                     "  -c    Connections (default 64)\n"
+                     "  -p    Requests in flight per connection (default 1)\n"
+                     "  -d    Length of the loopback test (default 2)\n",
+                     program);
+    }
+} // namespace
+
+/**
+ * Micro benchmarks of the request path (header lookup, parsing, formatting, serialisation)
+ * followed by an end-to-end loopback load test, with latency percentiles for each.
+ */
+int main(int argc, char* argv[]) {
+    Options options;
+    options.load.threads = std::max(1u, std::thread::hardware_concurrency());
+
+    int option;
+    while ((option = getopt(argc, argv, "f:s:jmt:C:c:p:d:h")) != -1) {
+        switch (option) {
+            case 'f': options.filter = optarg; break;
+            case 's': options.seconds = std::atof(optarg); break;
+            case 'j': options.json = true; break;
+            case 'm': options.instrumented = true; break;
+            case 't': options.reactors = static_cast<std::size_t>(std::atoi(optarg)); break;
+            case 'C': options.load.threads = static_cast<std::size_t>(std::atoi(optarg)); break;
+            case 'c': options.load.connections = static_cast<std::size_t>(std::atoi(optarg)); break;
+            case 'p': options.load.pipeline = static_cast<std::size_t>(std::atoi(optarg)); break;
+            case 'd': options.load.seconds = std::atof(optarg); break;
+            default: usage(argv[0]); return option == 'h' ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+
+    try {
+        std::vector<Report> reports = runMicro(options);
+        if (options.filter.empty() || std::string_view("e2e.loopback").find(options.filter) != std::string_view::npos) {
+            reports.push_back(runLoopback(options));
+        }
+
+        if (options.json) {
+            printJson(reports, options);
+        } else {
+            printTable(reports);
+        }
+    } catch (const std::exception& error) {
+        std::fprintf(stderr, "%s\n", error.what());
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,286 @@
+#include "load_generator.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include "http/field_value.h"
+
+namespace bench {
+    namespace {
+        using Clock = std::chrono::steady_clock;
+
+        struct Client {
+            int fd {-1};
+            std::string input;
+            std::deque<Clock::time_point> sent; //!< Send time of each request in flight, oldest first
+            bool until_close {false};           //!< The oldest response ends when the server closes
+        };
+
+        int connectLoopback(const uint16_t port) {
+            const int fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+            if (fd < 0) return -1;
+
+            sockaddr_in address {};
+            address.sin_family      = AF_INET;
+            address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            address.sin_port        = htons(port);
+            if (connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) < 0) {
+                close(fd);
+                return -1;
+            }
+
+            const int enable = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+            return fd;
+        }
+
+        bool sendAll(const int fd, const std::string_view data) {
+            std::size_t offset = 0;
+            while (offset < data.size()) {
+                const ssize_t sent = send(fd, data.data() + offset, data.size() - offset, MSG_NOSIGNAL);
+                if (sent < 0 && errno == EINTR) continue;
+                if (sent <= 0) return false;
+                offset += static_cast<std::size_t>(sent);
+            }
+            return true;
+        }
+
+        //! Framing of a response, read from its head
+        struct Framing {
+            unsigned status {0};
+            bool has_length {false};
+            std::size_t length {0};
+            bool chunked {false};
+            bool close {false};
+        };
+
+        /**
+         * @brief Reads the status and the framing fields of a response head, field names in
+         * any case
+         * @param[in] head    Status line and fields, without the empty line ending them
+         */
+        Framing readFraming(const std::string_view head) {
+            Framing framing;
+            const std::size_t space = head.find(' ');
+            if (space != std::string_view::npos) std::from_chars(head.data() + space + 1, head.data() + head.size(), framing.status);
+
+            std::size_t line_end = head.find("\r\n");
+            while (line_end != std::string_view::npos) {
+                const std::size_t start     = line_end + 2;
+                line_end                    = head.find("\r\n", start);
+                const std::string_view line = head.substr(start, line_end == std::string_view::npos ? std::string_view::npos : line_end - start);
+                const std::size_t colon     = line.find(':');
+                if (colon == std::string_view::npos) continue;
+
+                const std::string_view name  = line.substr(0, colon);
+                const std::string_view value = http::trim(line.substr(colon + 1));
+                if (http::equalsIgnoreCase(name, "content-length")) {
+                    framing.has_length = std::from_chars(value.data(), value.data() + value.size(), framing.length).ec == std::errc {};
+                } else if (http::equalsIgnoreCase(name, "transfer-encoding")) {
+                    // Only a final chunked coding frames the body (RFC 7230, 3.3.3)
+                    http::forEachListItem(value, [&](const std::string_view coding) {
+                        framing.chunked = http::equalsIgnoreCase(coding, "chunked");
+                        return true;
+                    });
+                } else if (http::equalsIgnoreCase(name, "connection")) {
+                    http::forEachListItem(value, [&](const std::string_view option) {
+                        framing.close = framing.close || http::equalsIgnoreCase(option, "close");
+                        return true;
+                    });
+                }
+            }
+            return framing;
+        }
+
+        /**
+         * @brief Finds the end of a chunked body (RFC 7230, 4.1), trailer fields included
+         * @param[in] position    Offset of the first chunk
+         * @return Offset just past the body, npos while it is incomplete
+         */
+        std::size_t chunkedEnd(const std::string_view input, std::size_t position) {
+            for (;;) {
+                const std::size_t line_end = input.find("\r\n", position);
+                if (line_end == std::string_view::npos) return std::string_view::npos;
+
+                // Chunk extensions after the size stop the parse and are ignored
+                std::size_t size = 0;
+                std::from_chars(input.data() + position, input.data() + line_end, size, 16);
+                position = line_end + 2;
+                if (size == 0) break;
+                position += size + 2;
+                if (position > input.size()) return std::string_view::npos;
+            }
+            for (;;) {
+                const std::size_t line_end = input.find("\r\n", position);
+                if (line_end == std::string_view::npos) return std::string_view::npos;
+                if (line_end == position) return position + 2;
+                position = line_end + 2;
+            }
+        }
+
+        /**
+         * Removes every complete response from the front of the client input and returns how
+         * many there were. closing is set when the server announced it will close the
+         * connection; a response without content-length or chunked coding sets until_close
+         * instead, as it only ends when the server closes.
+         */
+        std::size_t takeResponses(Client& client, const bool head_request, bool& closing) {
+            const std::string_view input = client.input;
+            std::size_t count            = 0;
+            std::size_t position         = 0;
+            for (;;) {
+                const std::size_t head_end = input.find("\r\n\r\n", position);
+                if (head_end == std::string_view::npos) break;
+
+                const Framing framing  = readFraming(input.substr(position, head_end - position));
+                const std::size_t body = head_end + 4;
+                const bool interim     = framing.status >= 100 && framing.status < 200;
+                const bool empty       = interim || framing.status == 204 || framing.status == 304 || head_request;
+                std::size_t next       = body;
+                if (!empty && framing.chunked) {
+                    next = chunkedEnd(input, body);
+                    if (next == std::string_view::npos) break;
+                } else if (!empty && framing.has_length) {
+                    next = body + framing.length;
+                    if (next > input.size()) break;
+                } else if (!empty) {
+                    client.until_close = true;
+                    break;
+                }
+
+                closing  = closing || framing.close;
+                position = next;
+                if (!interim) ++count;
+            }
+            client.input.erase(0, position);
+            return count;
+        }
+
+        void drive(const LoadOptions& options, const std::size_t connections, LoadResult& result) {
+            const int epoll = epoll_create1(EPOLL_CLOEXEC);
+            std::vector<Client> clients(connections);
+
+            // Requests replacing the answered ones go out in a single send
+            const std::size_t depth = std::max<std::size_t>(1, options.pipeline);
+            std::string batch;
+            for (std::size_t i = 0; i < depth; ++i) batch += options.request;
+            const bool head_request = std::string_view(options.request).substr(0, 5) == "HEAD ";
+
+            const auto issue = [&](Client& client, const std::size_t count) {
+                const Clock::time_point now = Clock::now();
+                client.sent.insert(client.sent.end(), count, now);
+                return sendAll(client.fd, std::string_view(batch).substr(0, count * options.request.size()));
+            };
+
+            const auto open = [&](Client& client) {
+                client.fd = connectLoopback(options.port);
+                if (client.fd < 0) return false;
+                if (!issue(client, depth)) {
+                    close(client.fd);
+                    client.fd = -1;
+                    return false;
+                }
+                epoll_event event {};
+                event.events   = EPOLLIN;
+                event.data.ptr = &client;
+                epoll_ctl(epoll, EPOLL_CTL_ADD, client.fd, &event);
+                return true;
+            };
+
+            for (Client& client : clients) {
+                if (!open(client)) ++result.errors;
+            }
+
+            const Clock::time_point start    = Clock::now();
+            const Clock::time_point deadline = start + std::chrono::duration_cast<Clock::duration>(
+                                                           std::chrono::duration<double>(options.seconds));
+            epoll_event events[64];
+            char chunk[16 * 1024];
+
+            while (Clock::now() < deadline) {
+                const int count = epoll_wait(epoll, events, 64, 10);
+                for (int i = 0; i < count; ++i) {
+                    Client& client         = *static_cast<Client*>(events[i].data.ptr);
+                    const ssize_t received = recv(client.fd, chunk, sizeof(chunk), 0);
+                    if (received < 0 && errno == EINTR) continue;
+                    // The end of the connection completes a response that had no length
+                    std::size_t responses = received == 0 && client.until_close ? 1 : 0;
+                    if (received < 0 || (received == 0 && !client.until_close)) ++result.errors;
+
+                    bool closing = received <= 0;
+                    if (received > 0) {
+                        client.input.append(chunk, static_cast<std::size_t>(received));
+                        responses = takeResponses(client, head_request, closing);
+                    }
+
+                    const Clock::time_point now = Clock::now();
+                    for (std::size_t r = 0; r < responses && !client.sent.empty(); ++r) {
+                        const auto latency = std::chrono::duration_cast<std::chrono::nanoseconds>(now - client.sent.front());
+                        result.latency.record(static_cast<uint64_t>(latency.count()));
+                        client.sent.pop_front();
+                    }
+                    result.requests += responses;
+
+                    // A connection that cannot take the next requests would otherwise wait forever
+                    if (!closing && responses > 0 && !issue(client, responses)) {
+                        ++result.errors;
+                        closing = true;
+                    }
+
+                    // The server closes persistent connections after a number of requests
+                    if (closing) {
+                        epoll_ctl(epoll, EPOLL_CTL_DEL, client.fd, nullptr);
+                        close(client.fd);
+                        client.input.clear();
+                        client.sent.clear();
+                        client.until_close = false;
+                        if (!open(client)) ++result.errors;
+                    }
+                }
+            }
+
+            result.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+            for (const Client& client : clients) {
+                if (client.fd >= 0) close(client.fd);
+            }
+            close(epoll);
+        }
+    } // namespace
+
+    LoadResult runLoad(const LoadOptions& options) {
+        const std::size_t threads = std::max<std::size_t>(1, options.threads);
+        std::vector<LoadResult> results(threads);
+        std::vector<std::thread> workers;
+
+        for (std::size_t i = 0; i < threads; ++i) {
+            // Spread the connections evenly, the first threads take the remainder
+            const std::size_t share = options.connections / threads + (i < options.connections % threads ? 1 : 0);
+            workers.emplace_back(drive, std::cref(options), share, std::ref(results[i]));
+        }
+
+        LoadResult total;
+        for (std::size_t i = 0; i < threads; ++i) {
+            workers[i].join();
+            total.requests += results[i].requests;
+            total.errors += results[i].errors;
+            total.seconds = std::max(total.seconds, results[i].seconds);
+            total.latency.merge(results[i].latency);
+        }
+        return total;
+    }
+} // namespace bench
@@ -0,0 +1,40 @@
+#ifndef BENCH_LOAD_GENERATOR_H
+#define BENCH_LOAD_GENERATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "metrics/histogram.h"
+
+namespace bench {
+    struct LoadOptions {
+        uint16_t port {8080};
+        std::size_t threads {1};      //!< Client threads, each with its own epoll instance
+        std::size_t connections {64}; //!< Persistent connections, spread over the threads
+        std::size_t pipeline {1};     //!< Requests kept in flight on each connection
+        double seconds {2.0};         //!< Measurement length
+        std::string request {"GET / HTTP/1.1\r\nHost: localhost\r\n\r\n"};
+    };
+
+    struct LoadResult {
+        uint64_t requests {0}; //!< Complete responses received
+        uint64_t errors {0};   //!< Connections that failed, could not send or were closed by the server
+        double seconds {0.0};
+        metrics::Histogram latency; //!< Nanoseconds from sending a request to its complete response
+
+        double rate() const {
+            return seconds > 0.0 ? static_cast<double>(requests) / seconds : 0.0;
+        }
+    };
+
+    /**
+     * @brief Drives a server on the loopback interface with closed-loop keep-alive clients,
+     * each keeping options.pipeline requests in flight
+     * @param[in] options    Load shape
+     * @return Totals over every client thread
+     */
+    LoadResult runLoad(const LoadOptions& options);
+} // namespace bench
+
+#endif // define BENCH_LOAD_GENERATOR_H
@@ -0,0 +1,82 @@
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <thread>
+#include <vector>
+
+#include "constants.h"
+#include "http/response.h"
+#include "load_generator.h"
+#include "net/server.h"
+
+namespace {
+    void usage(const char* program) {
+        std::fprintf(stderr,
+                     "Usage: %s [-t max reactors] [-C client threads] [-c connections] [-d seconds]\n",
+                     program);
+    }
+
+    void hello(const http::Request&, http::Response& response) {
+        response.set(http::headers::body_information::content_type, "text/plain");
+        response.body.assign("Hello from sagan\n");
+    }
+} // namespace
+
+/**
+ * Loopback scaling test: starts the server in-process with 1, 2, 4, ... reactor threads and
+ * measures requests per second with the same client load for each count.
+ */
+int main(int argc, char* argv[]) {
+    const std::size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+    std::size_t max_reactors   = hardware;
+    bench::LoadOptions load;
+    load.threads = hardware;
+
+    int option;
+    while ((option = getopt(argc, argv, "t:C:c:d:h")) != -1) {
+        switch (option) {
+            case 't': max_reactors = static_cast<std::size_t>(std::atoi(optarg)); break;
+            case 'C': load.threads = static_cast<std::size_t>(std::atoi(optarg)); break;
+            case 'c': load.connections = static_cast<std::size_t>(std::atoi(optarg)); break;
+            case 'd': load.seconds = std::atof(optarg); break;
+            default: usage(argv[0]); return option == 'h' ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+
+    std::vector<std::size_t> counts;
+    for (std::size_t reactors = 1; reactors < max_reactors; reactors *= 2) counts.push_back(reactors);
+    counts.push_back(std::max<std::size_t>(1, max_reactors));
+
+    std::printf("%zu client threads, %zu connections, %.1fs per run\n", load.threads, load.connections,
+                load.seconds);
+    std::printf("%10s %14s %10s %8s\n", "reactors", "requests/s", "speedup", "errors");
+
+    double baseline = 0.0;
+    try {
+        for (const std::size_t reactors : counts) {
+            net::Config config;
+            config.port    = 0;
+            config.threads = reactors;
+
+            net::Server server(config, hello);
+            server.start();
+            load.port = server.port();
+            const bench::LoadResult result = bench::runLoad(load);
+            server.stop();
+            server.join();
+
+            if (baseline == 0.0) baseline = result.rate();
+            std::printf("%10zu %14.0f %9.2fx %8llu\n", reactors, result.rate(),
+                        baseline > 0.0 ? result.rate() / baseline : 0.0,
+                        static_cast<unsigned long long>(result.errors));
+        }
+    } catch (const std::exception& error) {
+        std::fprintf(stderr, "%s\n", error.what());
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
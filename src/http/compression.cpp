@@ -0,0 +1,243 @@
+#include "http/compression.h"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <utility>
+
+#include "constants.h"
+#include "http/field_value.h"
+#include "memory/arena.h"
+
+namespace http {
+    namespace {
+        constexpr int kWindowBits             = 15;
+        constexpr int kMemoryLevel            = 8; // zlib's default, about 256 KiB of state per stream
+        constexpr std::size_t kChunkHeader    = 6; // Four hex digits and CRLF
+        constexpr std::string_view kLastChunk = "0\r\n\r\n";
+        constexpr std::size_t kNever          = SIZE_MAX;
+
+        // The most one write() appends: a full chunk with its framing, and the last chunk
+        constexpr std::size_t kChunkCapacity = kChunkHeader + kCompressedChunk + 2 + kLastChunk.size();
+
+        struct Threshold {
+            std::string_view media_type;
+            std::size_t minimum;
+        };
+
+        // Below these sizes the gzip framing and the chunk overhead eat most of the gain
+        constexpr Threshold kThresholds[] = {
+            { "text/html", 256 },           { "text/css", 256 },
+            { "text/javascript", 256 },     { "application/javascript", 256 },
+            { "application/json", 256 },    { "text/plain", 512 },
+            { "text/xml", 512 },            { "application/xml", 512 },
+            { "image/svg+xml", 512 },       { "text/csv", 512 },
+            { "application/wasm", 1024 },   { "image/x-icon", 1024 },
+            { "font/ttf", 1024 },           { "font/otf", 1024 },
+        };
+
+        /**
+         * @brief Quality of an accept-encoding element in thousandths, 1000 when absent
+         * @return -1 if the qvalue is malformed
+         */
+        int quality(std::string_view parameters) {
+            int result = 1000;
+            while (!parameters.empty()) {
+                const std::size_t semicolon = parameters.find(';');
+                const std::string_view item = trim(parameters.substr(0, semicolon));
+                parameters.remove_prefix(semicolon == std::string_view::npos ? parameters.size() : semicolon + 1);
+                if (item.size() < 2 || toLower(static_cast<uint8_t>(item[0])) != 'q' || item[1] != '=') continue;
+
+                const std::string_view value = item.substr(2);
+                if (value.empty() || (value[0] != '0' && value[0] != '1')) return -1;
+                result = (value[0] - '0') * 1000;
+                if (value.size() > 1) {
+                    if (value[1] != '.' || value.size() > 5) return -1;
+                    int scale = 100;
+                    for (std::size_t i = 2; i < value.size(); ++i, scale /= 10) {
+                        if (value[i] < '0' || value[i] > '9') return -1;
+                        result += (value[i] - '0') * scale;
+                    }
+                }
+                if (result > 1000) return -1;
+            }
+            return result;
+        }
+
+        //! Quality given to gzip and deflate by accept-encoding, -1 when not mentioned
+        void qualities(const std::string_view accept_encoding, int& gzip, int& deflate) {
+            int any = -1;
+            gzip = deflate = -1;
+            forEachListItem(accept_encoding, [&](const std::string_view item) {
+                const std::size_t semicolon = item.find(';');
+                const std::string_view coding = trim(item.substr(0, semicolon));
+                const int value = semicolon == std::string_view::npos ? 1000 : quality(item.substr(semicolon + 1));
+                if (equalsIgnoreCase(coding, "gzip") || equalsIgnoreCase(coding, "x-gzip")) {
+                    gzip = value;
+                } else if (equalsIgnoreCase(coding, "deflate")) {
+                    deflate = value;
+                } else if (coding == "*") {
+                    any = value;
+                }
+                return true;
+            });
+            if (gzip < 0) gzip = any;
+            if (deflate < 0) deflate = any;
+        }
+
+        void weakenEtag(Response& response) {
+            for (auto& field : response.fields) {
+                if (!equalsIgnoreCase(field.first, headers::conditionals::etag) || field.second.substr(0, 2) == "W/") continue;
+                char* weak = static_cast<char*>(response.arena().allocate(field.second.size() + 2, 1));
+                std::memcpy(weak, "W/", 2);
+                std::memcpy(weak + 2, field.second.data(), field.second.size());
+                field.second = std::string_view(weak, field.second.size() + 2);
+            }
+        }
+    } // namespace
+
+    Encoding negotiateEncoding(const std::string_view accept_encoding) {
+        int gzip, deflate;
+        qualities(accept_encoding, gzip, deflate);
+        if (gzip <= 0 && deflate <= 0) return Encoding::identity;
+        return gzip >= deflate ? Encoding::gzip : Encoding::deflate;
+    }
+
+    bool acceptsEncoding(const std::string_view accept_encoding, const Encoding encoding) {
+        if (encoding == Encoding::identity) return true;
+        int gzip, deflate;
+        qualities(accept_encoding, gzip, deflate);
+        return (encoding == Encoding::gzip ? gzip : deflate) > 0;
+    }
+
+    std::string_view encodingName(const Encoding encoding) {
+        switch (encoding) {
+            case Encoding::gzip: return "gzip";
+            case Encoding::deflate: return "deflate";
+            default: return "identity";
+        }
+    }
+
+    std::size_t minimumCompressedSize(const std::string_view content_type) {
+        const std::string_view media_type = trim(content_type.substr(0, content_type.find(';')));
+        for (const Threshold& threshold : kThresholds) {
+            if (equalsIgnoreCase(media_type, threshold.media_type)) return threshold.minimum;
+        }
+        if (media_type.size() > 5 && equalsIgnoreCase(media_type.substr(0, 5), "text/")) return 512;
+        return kNever;
+    }
+
+    Deflater::Deflater(const Encoding encoding, const int level) noexcept :
+        m_stream(new (std::nothrow) z_stream {}) {
+        if (!m_stream) return;
+
+        // 16 added to the window bits selects the gzip wrapper instead of zlib's
+        const int window  = encoding == Encoding::gzip ? kWindowBits + 16 : kWindowBits;
+        const int clamped = std::min(std::max(level, Z_BEST_SPEED), Z_BEST_COMPRESSION);
+        if (deflateInit2(m_stream.get(), clamped, Z_DEFLATED, window, kMemoryLevel, Z_DEFAULT_STRATEGY) != Z_OK) m_stream.reset();
+    }
+
+    Deflater::~Deflater() {
+        if (m_stream) deflateEnd(m_stream.get());
+    }
+
+    bool Deflater::write(std::string_view& input, const bool finish, memory::Buffer& out) {
+        out.reserve(kChunkCapacity);
+        std::size_t length = 0;
+        const bool ended   = deflateInto(input, finish, out.tail(), length);
+        out.commit(length);
+        return ended;
+    }
+
+    bool Deflater::write(std::string_view& input, const bool finish, memory::ArenaString& out) {
+        const std::size_t size = out.size();
+        out.resize(size + kChunkCapacity);
+        std::size_t length = 0;
+        const bool ended   = deflateInto(input, finish, out.data() + size, length);
+        out.resize(size + length);
+        return ended;
+    }
+
+    std::size_t Deflater::bound(const std::size_t size) const {
+        const std::size_t compressed = deflateBound(m_stream.get(), static_cast<uLong>(size));
+        const std::size_t chunks     = compressed / kCompressedChunk + 1;
+        return compressed + chunks * (kChunkHeader + 2) + kLastChunk.size();
+    }
+
+    bool Deflater::deflateInto(std::string_view& input, const bool finish, char* const chunk, std::size_t& length) {
+        m_stream->next_in   = reinterpret_cast<Bytef*>(const_cast<char*>(input.data()));
+        m_stream->avail_in  = static_cast<uInt>(input.size());
+        m_stream->next_out  = reinterpret_cast<Bytef*>(chunk + kChunkHeader);
+        m_stream->avail_out = static_cast<uInt>(kCompressedChunk);
+        const int status    = deflate(m_stream.get(), finish ? Z_FINISH : Z_NO_FLUSH);
+        input.remove_prefix(input.size() - m_stream->avail_in);
+
+        // The size is written with leading zeros so that the header has a fixed length
+        const std::size_t produced = kCompressedChunk - m_stream->avail_out;
+        length                     = 0;
+        if (produced > 0) {
+            constexpr char kHex[] = "0123456789abcdef";
+            for (int i = 0; i < 4; ++i) chunk[i] = kHex[(produced >> (12 - 4 * i)) & 0xf];
+            std::memcpy(chunk + 4, "\r\n", 2);
+            std::memcpy(chunk + kChunkHeader + produced, "\r\n", 2);
+            length = kChunkHeader + produced + 2;
+        }
+
+        const bool ended = status == Z_STREAM_END;
+        if (ended) {
+            std::memcpy(chunk + length, kLastChunk.data(), kLastChunk.size());
+            length += kLastChunk.size();
+        }
+        return ended;
+    }
+
+    std::unique_ptr<Deflater> compressResponse(const Request& request, Response& response, const int level) {
+        // HTTP/1.0 has no chunked coding, and ranges address the identity representation
+        if (level <= 0 || request.version_minor == 0) return nullptr;
+        if (!allowsBody(response.status) || response.status == 206 || response.chunked) return nullptr;
+
+        std::string_view content_type;
+        bool varies = false;
+        for (const auto& field : response.fields) {
+            if (equalsIgnoreCase(field.first, headers::body_information::content_encoding)) return nullptr;
+            if (equalsIgnoreCase(field.first, headers::body_information::content_type)) content_type = field.second;
+            if (equalsIgnoreCase(field.first, headers::conditionals::vary)) {
+                forEachListItem(field.second, [&](const std::string_view name) {
+                    varies = equalsIgnoreCase(name, headers::content_negotiation::accept_encoding);
+                    return !varies;
+                });
+            }
+        }
+
+        const uint64_t size = response.file.fd >= 0 ? response.file.length : response.body.size();
+        if (size < minimumCompressedSize(content_type)) return nullptr;
+
+        // Whether or not this client gets it compressed, the representation depends on accept-encoding
+        if (!varies) response.set(headers::conditionals::vary, "accept-encoding");
+        const Encoding encoding = negotiateEncoding(request.header(headers::Id::accept_encoding));
+        if (encoding == Encoding::identity) return nullptr;
+
+        // Without memory for zlib the response goes out uncompressed rather than failing
+        std::unique_ptr<Deflater> deflater;
+        if (request.method != Method::head) {
+            deflater.reset(new (std::nothrow) Deflater(encoding, level));
+            if (!deflater || !deflater->ready()) return nullptr;
+        }
+
+        weakenEtag(response);
+        response.set(headers::body_information::content_encoding, encodingName(encoding));
+        response.chunked = true;
+        if (!deflater) return nullptr; // HEAD only announces the coding
+        if (response.file.fd >= 0) return deflater;
+
+        // Chunks go straight into the arena; with room for the bound the string never moves
+        memory::ArenaString compressed(response.body.get_allocator());
+        compressed.reserve(deflater->bound(response.body.size()) + kChunkCapacity);
+        std::string_view input(response.body);
+        while (!deflater->write(input, true, compressed)) {}
+        response.body = std::move(compressed);
+        return nullptr;
+    }
+} // namespace http
@@ -0,0 +1,117 @@
+#ifndef HTTP_COMPRESSION_H
+#define HTTP_COMPRESSION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+
+#include "http/request_parser.h"
+#include "http/response.h"
+#include "memory/buffer.h"
+
+typedef struct z_stream_s z_stream;
+
+namespace http {
+    enum class Encoding : uint8_t { identity, deflate, gzip };
+
+    /**
+     * Largest compressed payload of one chunk. With its framing a chunk fits a pooled buffer,
+     * and the size always fits the four hex digits written by Deflater.
+     */
+    constexpr std::size_t kCompressedChunk = 16 * 1024 - 16;
+
+    /**
+     * @brief Picks the content coding for a response from accept-encoding (RFC 7231, 5.3.4)
+     * @return The acceptable coding with the highest quality, gzip on ties, identity when the
+     * header is absent or accepts neither gzip nor deflate
+     */
+    Encoding negotiateEncoding(std::string_view accept_encoding);
+
+    /**
+     * @brief Whether accept-encoding allows a coding, explicitly or through "*"
+     */
+    bool acceptsEncoding(std::string_view accept_encoding, Encoding encoding);
+
+    //! Value of the content-encoding header for a coding
+    std::string_view encodingName(Encoding encoding);
+
+    /**
+     * @brief Smallest body worth compressing for a media type
+     * @param[in] content_type    Value of the content-type header, parameters are ignored
+     * @return SIZE_MAX for media types that are already compressed or unknown
+     */
+    std::size_t minimumCompressedSize(std::string_view content_type);
+
+    /**
+     * Incremental zlib compressor writing the chunked transfer coding (RFC 7230, 4.1). Input
+     * is taken in any slices and never held beyond the call; output is produced one bounded
+     * chunk at a time, so compressing a body of any size needs a fixed amount of memory.
+     */
+    class Deflater {
+    public:
+        /**
+         * @param[in] encoding    gzip or deflate (the zlib format, as HTTP defines it)
+         * @param[in] level       zlib compression level, clamped to 1 to 9
+         * @note Never throws, check ready() before use
+         */
+        Deflater(Encoding encoding, int level) noexcept;
+        ~Deflater();
+
+        /**
+         * @brief Whether zlib could allocate its state, write() must not be called otherwise
+         */
+        bool ready() const {
+            return m_stream != nullptr;
+        }
+
+        Deflater(const Deflater&) = delete;
+        Deflater& operator=(const Deflater&) = delete;
+
+        /**
+         * @brief Compresses input, appending at most one chunk to out
+         * @param[in,out] input     Bytes to compress, the consumed prefix is removed
+         * @param[in]     finish    input holds the end of the body: flush and end the stream
+         * @param[out]    out       Receives the chunk, and the last chunk once the stream ends
+         * @return True once the stream has ended; call again while input is not empty or, when
+         * finishing, until it returns true
+         */
+        bool write(std::string_view& input, bool finish, memory::Buffer& out);
+
+        /**
+         * @brief Same as above, appending to a body kept in the response arena
+         */
+        bool write(std::string_view& input, bool finish, memory::ArenaString& out);
+
+        /**
+         * @brief Upper bound of the chunked output for a body of this size, with its last chunk
+         */
+        std::size_t bound(std::size_t size) const;
+
+    private:
+        std::unique_ptr<z_stream> m_stream;
+
+        /**
+         * @brief Compresses into chunk, which has room for kChunkCapacity bytes
+         * @param[out] length    Bytes written to chunk
+         * @return True once the stream has ended
+         */
+        bool deflateInto(std::string_view& input, bool finish, char* chunk, std::size_t& length);
+    };
+
+    /**
+     * Compression stage, run between the handler and serialize(). When the client accepts
+     * gzip or deflate and the body is large enough for its media type, the response gets
+     * content-encoding, vary: accept-encoding and the chunked transfer coding, and a strong
+     * etag is weakened since the bytes differ from the identity representation.
+     * A body in memory is compressed right away, chunk by chunk; a file body is left to the
+     * returned Deflater, which the connection feeds as the socket drains.
+     * @param[in]     request     The request being answered
+     * @param[in,out] response    The handler's response
+     * @param[in]     level       zlib compression level
+     * @return The compressor for a file body, nullptr otherwise
+     */
+    std::unique_ptr<Deflater> compressResponse(const Request& request, Response& response, int level);
+} // namespace http
+
+#endif // define HTTP_COMPRESSION_H
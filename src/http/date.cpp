@@ -0,0 +1,87 @@
+#include "http/date.h"
+
+namespace http {
+    namespace {
+        constexpr char kDays[7][4]    = { "Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat" };
+        constexpr char kMonths[12][4] = { "Jan", "Feb", "Mar", "Apr", "May", "Jun",
+                                          "Jul", "Aug", "Sep", "Oct", "Nov", "Dec" };
+
+        char* writeTwoDigits(char* out, const int value) {
+            out[0] = static_cast<char>('0' + value / 10);
+            out[1] = static_cast<char>('0' + value % 10);
+            return out + 2;
+        }
+
+        bool readNumber(const std::string_view digits, int& value) {
+            value = 0;
+            for (const char c : digits) {
+                if (c < '0' || c > '9') return false;
+                value = value * 10 + (c - '0');
+            }
+            return true;
+        }
+
+        char* writeName(char* out, const char* name) {
+            out[0] = name[0];
+            out[1] = name[1];
+            out[2] = name[2];
+            return out + 3;
+        }
+    } // namespace
+
+    std::string_view formatDate(const std::time_t time, char* out) {
+        std::tm parts {};
+        gmtime_r(&time, &parts);
+
+        char* cursor = writeName(out, kDays[parts.tm_wday]);
+        *cursor++    = ',';
+        *cursor++    = ' ';
+        cursor       = writeTwoDigits(cursor, parts.tm_mday);
+        *cursor++    = ' ';
+        cursor       = writeName(cursor, kMonths[parts.tm_mon]);
+        *cursor++    = ' ';
+        cursor       = writeTwoDigits(cursor, (parts.tm_year + 1900) / 100);
+        cursor       = writeTwoDigits(cursor, (parts.tm_year + 1900) % 100);
+        *cursor++    = ' ';
+        cursor       = writeTwoDigits(cursor, parts.tm_hour);
+        *cursor++    = ':';
+        cursor       = writeTwoDigits(cursor, parts.tm_min);
+        *cursor++    = ':';
+        cursor       = writeTwoDigits(cursor, parts.tm_sec);
+        *cursor++    = ' ';
+        writeName(cursor, "GMT");
+
+        return std::string_view(out, kDateLength);
+    }
+
+    bool parseDate(const std::string_view value, std::time_t& time) {
+        // "Sun, 06 Nov 1994 08:49:37 GMT"
+        if (value.size() != kDateLength || value.substr(3, 2) != ", " || value.substr(25) != " GMT") return false;
+        if (value[7] != ' ' || value[11] != ' ' || value[16] != ' ' || value[19] != ':' || value[22] != ':') return false;
+
+        int month = -1;
+        for (int i = 0; i < 12; ++i) {
+            if (value.substr(8, 3) == kMonths[i]) month = i;
+        }
+        if (month < 0) return false;
+
+        std::tm parts {};
+        int year = 0;
+        if (!readNumber(value.substr(5, 2), parts.tm_mday) || !readNumber(value.substr(12, 4), year) ||
+            !readNumber(value.substr(17, 2), parts.tm_hour) || !readNumber(value.substr(20, 2), parts.tm_min) ||
+            !readNumber(value.substr(23, 2), parts.tm_sec)) {
+            return false;
+        }
+        parts.tm_mon  = month;
+        parts.tm_year = year - 1900;
+
+        time = timegm(&parts);
+        return time != static_cast<std::time_t>(-1);
+    }
+
+    void DateCache::update(const std::time_t now) {
+        if (now == m_time) return;
+        m_time = now;
+        formatDate(now, m_value);
+    }
+} // namespace http
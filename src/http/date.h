@@ -0,0 +1,49 @@
+#ifndef HTTP_DATE_H
+#define HTTP_DATE_H
+
+#include <cstddef>
+#include <ctime>
+#include <string_view>
+
+namespace http {
+    constexpr std::size_t kDateLength = 29; // "Sun, 06 Nov 1994 08:49:37 GMT"
+
+    /**
+     * @brief Formats a timestamp as an IMF-fixdate (RFC 7231, 7.1.1.1) without touching the locale
+     * @param[in]  time    Seconds since the epoch
+     * @param[out] out     Buffer of at least kDateLength bytes, not null terminated
+     * @return View over the formatted date inside out
+     */
+    std::string_view formatDate(std::time_t time, char* out);
+
+    /**
+     * @brief Parses an IMF-fixdate, as found in if-modified-since and similar headers
+     * @param[in]  value    Header value
+     * @param[out] time     Seconds since the epoch
+     * @return False if the value is not an IMF-fixdate (obsolete formats are not accepted)
+     */
+    bool parseDate(std::string_view value, std::time_t& time);
+
+    /**
+     * Keeps the current date formatted for the Date header. Each reactor owns one, so the
+     * string is rebuilt at most once per second per thread.
+     */
+    class DateCache {
+    public:
+        /**
+         * @brief Refreshes the cached string if the second changed
+         * @param[in] now    Current time, seconds since the epoch
+         */
+        void update(std::time_t now);
+
+        std::string_view value() const {
+            return std::string_view(m_value, kDateLength);
+        }
+
+    private:
+        std::time_t m_time {-1};
+        char m_value[kDateLength] {};
+    };
+} // namespace http
+
+#endif // define HTTP_DATE_H
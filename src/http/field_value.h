@@ -0,0 +1,49 @@
+#ifndef HTTP_FIELD_VALUE_H
+#define HTTP_FIELD_VALUE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace http {
+    constexpr uint8_t toLower(const uint8_t c) {
+        return (c >= 'A' && c <= 'Z') ? static_cast<uint8_t>(c | 0x20) : c;
+    }
+
+    /**
+     * @brief ASCII case-insensitive comparison, as used for header names and most tokens
+     */
+    constexpr bool equalsIgnoreCase(const std::string_view lhs, const std::string_view rhs) {
+        if (lhs.size() != rhs.size()) return false;
+        for (std::size_t i = 0; i < lhs.size(); ++i) {
+            if (toLower(static_cast<uint8_t>(lhs[i])) != toLower(static_cast<uint8_t>(rhs[i]))) return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Removes leading and trailing optional whitespace (SP and HTAB)
+     */
+    constexpr std::string_view trim(std::string_view value) {
+        while (!value.empty() && (value.front() == ' ' || value.front() == '\t')) value.remove_prefix(1);
+        while (!value.empty() && (value.back() == ' ' || value.back() == '\t')) value.remove_suffix(1);
+        return value;
+    }
+
+    /**
+     * Calls visitor with every trimmed, non-empty element of a comma-separated field value
+     * (RFC 7230, 7). The visitor returns false to stop early.
+     */
+    template <typename Visitor>
+    void forEachListItem(std::string_view value, Visitor&& visitor) {
+        while (!value.empty()) {
+            const std::size_t comma     = value.find(',');
+            const std::string_view item = trim(value.substr(0, comma));
+            if (!item.empty() && !visitor(item)) return;
+            if (comma == std::string_view::npos) return;
+            value.remove_prefix(comma + 1);
+        }
+    }
+} // namespace http
+
+#endif // define HTTP_FIELD_VALUE_H
@@ -0,0 +1,104 @@
+#include "http/file_cache.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <charconv>
+
+namespace http {
+    namespace {
+        bool sameFile(const CachedFile& file, const struct stat& status) {
+            return file.device == status.st_dev && file.inode == status.st_ino &&
+                   file.size == static_cast<uint64_t>(status.st_size) && file.modified == status.st_mtime;
+        }
+
+        void appendHex(std::string& out, const uint64_t value) {
+            char digits[16];
+            const auto result = std::to_chars(digits, digits + sizeof(digits), value, 16);
+            out.append(digits, static_cast<std::size_t>(result.ptr - digits));
+        }
+    } // namespace
+
+    CachedFile::~CachedFile() {
+        if (fd >= 0) close(fd);
+    }
+
+    FileCache::FileCache(const std::size_t capacity, const uint32_t revalidate) :
+        m_capacity(capacity), m_revalidate(revalidate) {}
+
+    FileCache::FileCache(const FileCache& other) :
+        m_capacity(other.m_capacity), m_revalidate(other.m_revalidate) {}
+
+    std::shared_ptr<const CachedFile> FileCache::get(const std::string_view path, const std::time_t now, int& error) {
+        const auto found = m_index.find(path);
+        if (found != m_index.end()) {
+            const auto entry = found->second;
+            m_entries.splice(m_entries.begin(), m_entries, entry);
+
+            if (now - entry->checked < static_cast<std::time_t>(m_revalidate)) {
+                if (entry->file == nullptr) error = ENOENT;
+                return entry->file;
+            }
+
+            struct stat status {};
+            if (entry->file != nullptr && stat(entry->path.c_str(), &status) == 0 && sameFile(*entry->file, status)) {
+                entry->checked = now;
+                return entry->file;
+            }
+
+            // Replaced, modified or removed: connections still sending the old file keep it open
+            m_index.erase(found);
+            m_entries.erase(entry);
+        }
+
+        std::string key(path);
+        std::shared_ptr<CachedFile> file = open(key, error);
+        if (file == nullptr && error != ENOENT) return nullptr;
+
+        m_entries.push_front(Entry {std::move(key), file, now});
+        m_index.emplace(m_entries.front().path, m_entries.begin());
+        if (m_entries.size() > m_capacity) {
+            m_index.erase(m_entries.back().path);
+            m_entries.pop_back();
+        }
+        return file;
+    }
+
+    std::shared_ptr<CachedFile> FileCache::open(const std::string& path, int& error) const {
+        auto file = std::make_shared<CachedFile>();
+        file->fd  = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (file->fd < 0) {
+            error = errno;
+            return nullptr;
+        }
+
+        struct stat status {};
+        if (fstat(file->fd, &status) < 0) {
+            error = errno;
+            return nullptr;
+        }
+        if (S_ISDIR(status.st_mode)) {
+            error = EISDIR;
+            return nullptr;
+        }
+        if (!S_ISREG(status.st_mode)) {
+            error = EACCES;
+            return nullptr;
+        }
+
+        file->size     = static_cast<uint64_t>(status.st_size);
+        file->modified = status.st_mtime;
+        file->device   = status.st_dev;
+        file->inode    = status.st_ino;
+        formatDate(file->modified, file->last_modified);
+
+        file->etag.push_back('"');
+        appendHex(file->etag, static_cast<uint64_t>(file->modified));
+        file->etag.push_back('-');
+        appendHex(file->etag, file->size);
+        file->etag.push_back('"');
+        return file;
+    }
+} // namespace http
@@ -0,0 +1,91 @@
+#ifndef HTTP_FILE_CACHE_H
+#define HTTP_FILE_CACHE_H
+
+#include <sys/types.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <list>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "http/date.h"
+
+namespace http {
+    //! An open file and the metadata needed to answer requests for it
+    struct CachedFile {
+        CachedFile() = default;
+        ~CachedFile();
+
+        CachedFile(const CachedFile&) = delete;
+        CachedFile& operator=(const CachedFile&) = delete;
+
+        int fd {-1};
+        uint64_t size {0};
+        std::time_t modified {0};
+        dev_t device {0};
+        ino_t inode {0};
+        std::string etag;                   //!< Strong validator, quoted
+        char last_modified[kDateLength] {}; //!< Preformatted modification date
+
+        std::string_view lastModified() const {
+            return std::string_view(last_modified, kDateLength);
+        }
+    };
+
+    /**
+     * Bounded LRU cache of open regular files keyed by path. A hit costs no system call; an
+     * entry is only checked against the file system again (with stat) once it is older than
+     * the revalidation interval, and reopened if the file was replaced or modified. Missing
+     * files are remembered for the same interval, so probing for optional files (such as
+     * precompressed siblings) is cheap too. The cache is not thread-safe, each reactor owns
+     * its own.
+     */
+    class FileCache {
+    public:
+        /**
+         * @param[in] capacity      Maximum number of open files
+         * @param[in] revalidate    Seconds an entry is trusted without looking at the file system
+         */
+        FileCache(std::size_t capacity, uint32_t revalidate);
+
+        /**
+         * Copies start empty and only share the configuration, open descriptors are never
+         * shared between threads.
+         */
+        FileCache(const FileCache& other);
+        FileCache& operator=(const FileCache&) = delete;
+
+        /**
+         * @brief Finds or opens a regular file
+         * @param[in]  path     File path
+         * @param[in]  now      Current time, seconds since the epoch
+         * @param[out] error    errno value when the file cannot be served (EISDIR for directories)
+         * @return The file, or nullptr on error
+         */
+        std::shared_ptr<const CachedFile> get(std::string_view path, std::time_t now, int& error);
+
+        std::size_t size() const {
+            return m_entries.size();
+        }
+
+    private:
+        struct Entry {
+            std::string path;
+            std::shared_ptr<CachedFile> file; //!< nullptr when the path does not exist
+            std::time_t checked {0};          //!< Last time the path was looked up
+        };
+
+        std::size_t m_capacity;
+        uint32_t m_revalidate;
+        std::list<Entry> m_entries; // Most recently used first
+        std::unordered_map<std::string_view, std::list<Entry>::iterator> m_index; // Keys view Entry::path
+
+        std::shared_ptr<CachedFile> open(const std::string& path, int& error) const;
+    };
+} // namespace http
+
+#endif // define HTTP_FILE_CACHE_H
@@ -0,0 +1,158 @@
+#ifndef HTTP_HEADERS_H
+#define HTTP_HEADERS_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "constants.h"
+#include "http/field_value.h"
+
+namespace http {
+    namespace headers {
+        /**
+         * Dense identifier for every known header, usable as an array index.
+         * Id::unknown is returned by lookup() for names that are not registered.
+         */
+        enum class Id : uint8_t {
+#define SAGAN_HTTP_HEADER_ID(group, name, value) name,
+            SAGAN_HTTP_HEADERS(SAGAN_HTTP_HEADER_ID)
+#undef SAGAN_HTTP_HEADER_ID
+            unknown
+        };
+
+        constexpr std::size_t kCount = static_cast<std::size_t>(Id::unknown);
+        static_assert(kCount < 0xFF, "Header identifiers must fit in a byte");
+
+        namespace detail {
+            constexpr std::array<std::string_view, kCount> kNames {
+#define SAGAN_HTTP_HEADER_NAME(group, name, value) std::string_view { group::name },
+                SAGAN_HTTP_HEADERS(SAGAN_HTTP_HEADER_NAME)
+#undef SAGAN_HTTP_HEADER_NAME
+            };
+
+            constexpr std::size_t kBuckets = 64;  // First level, one displacement seed each
+            constexpr std::size_t kSlots   = 256; // Second level, holds the header identifiers
+            static_assert((kSlots & (kSlots - 1)) == 0, "Slot count must be a power of two");
+            static_assert(kSlots > kCount, "Not enough slots for every header");
+
+            // FNV-1a over the lowercased bytes so that lookups are case-insensitive
+            constexpr uint64_t hash(const std::string_view name) {
+                uint64_t value = 0xcbf29ce484222325ULL;
+                for (const char c : name) {
+                    value ^= toLower(static_cast<uint8_t>(c));
+                    value *= 0x100000001b3ULL;
+                }
+                return value;
+            }
+
+            constexpr std::size_t bucketOf(const uint64_t hashed) {
+                return static_cast<std::size_t>(hashed >> 32) % kBuckets;
+            }
+
+            // Murmur3 finalizer, spreads the displaced hash over the slot table
+            constexpr std::size_t slotOf(const uint64_t hashed, const uint16_t seed) {
+                uint64_t value = hashed ^ (seed * 0x9e3779b97f4a7c15ULL);
+                value ^= value >> 33;
+                value *= 0xff51afd7ed558ccdULL;
+                value ^= value >> 33;
+                value *= 0xc4ceb9fe1a85ec53ULL;
+                value ^= value >> 33;
+                return static_cast<std::size_t>(value) & (kSlots - 1);
+            }
+
+            struct PerfectHash {
+                std::array<uint16_t, kBuckets> seeds {};
+                std::array<Id, kSlots> slots {};
+                bool complete {false};
+            };
+
+            /**
+             * Hash-and-displace construction: buckets are placed from the most to the least
+             * populated, searching for the first seed that moves every member of the bucket
+             * into a free slot.
+             */
+            constexpr PerfectHash buildPerfectHash() {
+                PerfectHash table {};
+                for (auto& slot : table.slots) slot = Id::unknown;
+
+                std::array<uint64_t, kCount> hashes {};
+                std::array<std::size_t, kBuckets> sizes {};
+                for (std::size_t i = 0; i < kCount; ++i) {
+                    hashes[i] = hash(kNames[i]);
+                    ++sizes[bucketOf(hashes[i])];
+                }
+
+                std::array<std::size_t, kBuckets> order {};
+                for (std::size_t i = 0; i < kBuckets; ++i) order[i] = i;
+                for (std::size_t i = 0; i < kBuckets; ++i) {
+                    for (std::size_t j = i + 1; j < kBuckets; ++j) {
+                        if (sizes[order[j]] > sizes[order[i]]) {
+                            const std::size_t tmp = order[i];
+                            order[i]              = order[j];
+                            order[j]              = tmp;
+                        }
+                    }
+                }
+
+                for (const std::size_t bucket : order) {
+                    if (sizes[bucket] == 0) break;
+
+                    bool placed = false;
+                    for (uint32_t seed = 0; seed <= 0xFFFF && !placed; ++seed) {
+                        std::array<Id, kSlots> attempt = table.slots;
+                        placed = true;
+                        for (std::size_t i = 0; i < kCount && placed; ++i) {
+                            if (bucketOf(hashes[i]) != bucket) continue;
+                            const std::size_t slot = slotOf(hashes[i], static_cast<uint16_t>(seed));
+                            if (attempt[slot] != Id::unknown) {
+                                placed = false;
+                            } else {
+                                attempt[slot] = static_cast<Id>(i);
+                            }
+                        }
+                        if (placed) {
+                            table.slots         = attempt;
+                            table.seeds[bucket] = static_cast<uint16_t>(seed);
+                        }
+                    }
+                    if (!placed) return table;
+                }
+
+                table.complete = true;
+                return table;
+            }
+
+            constexpr PerfectHash kTable = buildPerfectHash();
+            static_assert(kTable.complete, "Could not build a perfect hash for the header list");
+        } // namespace detail
+
+        /**
+         * @brief Resolves a header name to its identifier in O(1), without allocating
+         * @param[in] name    Header name as received, compared case-insensitively
+         * @return The header identifier or Id::unknown if the name is not registered
+         */
+        constexpr Id lookup(const std::string_view name) {
+            const uint64_t hashed = detail::hash(name);
+            const Id id = detail::kTable.slots[detail::slotOf(hashed, detail::kTable.seeds[detail::bucketOf(hashed)])];
+            if (id == Id::unknown) return Id::unknown;
+            return equalsIgnoreCase(name, detail::kNames[static_cast<std::size_t>(id)]) ? id : Id::unknown;
+        }
+
+        /**
+         * @brief Canonical name of a header, as declared in constants.h
+         * @param[in] id    Header identifier
+         * @return The header name or an empty view for Id::unknown
+         */
+        constexpr std::string_view name(const Id id) {
+            return id == Id::unknown ? std::string_view {} : detail::kNames[static_cast<std::size_t>(id)];
+        }
+
+        static_assert(lookup("Content-Length") == Id::content_length, "Lookup must ignore case");
+        static_assert(lookup("x-robots-tag") == Id::x_robots_tag, "Lookup must find the last header");
+        static_assert(lookup("x-not-a-header") == Id::unknown, "Unknown names must not match");
+    } // namespace headers
+} // namespace http
+
+#endif // define HTTP_HEADERS_H
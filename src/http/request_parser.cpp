@@ -0,0 +1,193 @@
+#include "http/request_parser.h"
+
+#include <algorithm>
+
+#include "http/field_value.h"
+#include "http/scan.h"
+
+namespace http {
+    namespace {
+        Method toMethod(const std::string_view name) {
+            switch (name.size()) {
+                case 3:
+                    if (name == "GET") return Method::get;
+                    if (name == "PUT") return Method::put;
+                    break;
+                case 4:
+                    if (name == "HEAD") return Method::head;
+                    if (name == "POST") return Method::post;
+                    break;
+                case 5:
+                    if (name == "PATCH") return Method::patch;
+                    if (name == "TRACE") return Method::trace;
+                    break;
+                case 6:
+                    if (name == "DELETE") return Method::delete_;
+                    break;
+                case 7:
+                    if (name == "OPTIONS") return Method::options;
+                    if (name == "CONNECT") return Method::connect;
+                    break;
+                default:
+                    break;
+            }
+            return Method::unknown;
+        }
+
+        bool isWhitespace(const char c) {
+            return c == ' ' || c == '\t';
+        }
+
+        /**
+         * Moves cursor past the line terminator it points to, accepting a bare LF as RFC 7230
+         * allows. The cursor is left untouched unless the result is ParseResult::complete.
+         */
+        ParseResult skipNewline(const char*& cursor, const char* end) {
+            if (*cursor == '\n') {
+                ++cursor;
+                return ParseResult::complete;
+            }
+            if (*cursor != '\r') return ParseResult::invalid;
+            if (cursor + 1 == end) return ParseResult::incomplete;
+            if (cursor[1] != '\n') return ParseResult::invalid;
+            cursor += 2;
+            return ParseResult::complete;
+        }
+    } // namespace
+
+    std::string_view Request::header(const headers::Id id) const {
+        if (id == headers::Id::unknown) return {};
+        for (std::size_t i = 0; i < field_count; ++i) {
+            if (fields[i].id == id) return fields[i].value;
+        }
+        return {};
+    }
+
+    bool Request::keepAlive() const {
+        bool close      = false;
+        bool keep_alive  = false;
+        forEachListItem(header(headers::Id::connection), [&](const std::string_view option) {
+            if (equalsIgnoreCase(option, "close")) close = true;
+            if (equalsIgnoreCase(option, "keep-alive")) keep_alive = true;
+            return true;
+        });
+        if (close) return false;
+        return version_minor == 1 || keep_alive;
+    }
+
+    ParseResult RequestParser::parse(const std::string_view buffer, Request& request) {
+        const char* begin = buffer.data();
+        const char* end   = begin + std::min(buffer.size(), kMaxHeadSize);
+
+        while (m_state != State::done) {
+            const ParseResult result = m_state == State::request_line ? parseRequestLine(begin, end)
+                                                                       : parseField(begin, end);
+            if (result == ParseResult::incomplete && buffer.size() >= kMaxHeadSize) return ParseResult::too_large;
+            if (result != ParseResult::complete) return result;
+        }
+
+        fill(begin, request);
+        return ParseResult::complete;
+    }
+
+    void RequestParser::reset() {
+        m_state       = State::request_line;
+        m_position    = 0;
+        m_field_count = 0;
+    }
+
+    ParseResult RequestParser::parseRequestLine(const char* buffer, const char* end) {
+        const char* cursor = buffer + m_position;
+
+        // Empty lines ahead of the request line must be ignored (RFC 7230, 3.5)
+        while (cursor != end && (*cursor == '\r' || *cursor == '\n')) {
+            const ParseResult result = skipNewline(cursor, end);
+            if (result != ParseResult::complete) return result;
+            m_position = static_cast<std::size_t>(cursor - buffer);
+        }
+
+        const char* method_end = scan::findNonToken(cursor, end);
+        if (method_end == end) return ParseResult::incomplete;
+        if (method_end == cursor || *method_end != ' ') return ParseResult::invalid;
+
+        const char* target     = method_end + 1;
+        const char* target_end = scan::findSpaceOrControl(target, end);
+        if (target_end == end) return ParseResult::incomplete;
+        if (target_end == target || *target_end != ' ') return ParseResult::invalid;
+
+        constexpr std::string_view kVersionPrefix = "HTTP/1.";
+        const char* version = target_end + 1;
+        if (end - version < static_cast<std::ptrdiff_t>(kVersionPrefix.size() + 2)) return ParseResult::incomplete;
+        if (std::string_view(version, kVersionPrefix.size()) != kVersionPrefix) return ParseResult::invalid;
+
+        const char minor = version[kVersionPrefix.size()];
+        if (minor != '0' && minor != '1') return ParseResult::invalid;
+
+        const char* line_end     = version + kVersionPrefix.size() + 1;
+        const ParseResult result = skipNewline(line_end, end);
+        if (result != ParseResult::complete) return result;
+
+        m_method_name   = { static_cast<uint32_t>(cursor - buffer), static_cast<uint32_t>(method_end - cursor) };
+        m_method        = toMethod(std::string_view(cursor, static_cast<std::size_t>(method_end - cursor)));
+        m_target        = { static_cast<uint32_t>(target - buffer), static_cast<uint32_t>(target_end - target) };
+        m_version_minor = static_cast<uint8_t>(minor - '0');
+        m_position      = static_cast<std::size_t>(line_end - buffer);
+        m_state         = State::fields;
+        return ParseResult::complete;
+    }
+
+    ParseResult RequestParser::parseField(const char* buffer, const char* end) {
+        const char* cursor = buffer + m_position;
+        if (cursor == end) return ParseResult::incomplete;
+
+        if (*cursor == '\r' || *cursor == '\n') {
+            const ParseResult result = skipNewline(cursor, end);
+            if (result != ParseResult::complete) return result;
+            m_position = static_cast<std::size_t>(cursor - buffer);
+            m_state    = State::done;
+            return ParseResult::complete;
+        }
+
+        // A line starting with whitespace is an obsolete line folding and ends here as invalid
+        const char* name_end = scan::findNonToken(cursor, end);
+        if (name_end == end) return ParseResult::incomplete;
+        if (name_end == cursor || *name_end != ':') return ParseResult::invalid;
+
+        const char* value = name_end + 1;
+        while (value != end && isWhitespace(*value)) ++value;
+
+        const char* value_end = scan::findLineEnd(value, end);
+        if (value_end == end) return ParseResult::incomplete;
+
+        const char* line_end     = value_end;
+        const ParseResult result = skipNewline(line_end, end);
+        if (result != ParseResult::complete) return result;
+
+        while (value_end != value && isWhitespace(value_end[-1])) --value_end;
+
+        if (m_field_count == kMaxHeaders) return ParseResult::too_large;
+
+        const std::string_view name(cursor, static_cast<std::size_t>(name_end - cursor));
+        m_fields[m_field_count++] = {
+            headers::lookup(name),
+            { static_cast<uint32_t>(cursor - buffer), static_cast<uint32_t>(name.size()) },
+            { static_cast<uint32_t>(value - buffer), static_cast<uint32_t>(value_end - value) }
+        };
+        m_position = static_cast<std::size_t>(line_end - buffer);
+        return ParseResult::complete;
+    }
+
+    void RequestParser::fill(const char* buffer, Request& request) const {
+        const auto view = [buffer](const Span span) { return std::string_view(buffer + span.offset, span.length); };
+
+        request.method        = m_method;
+        request.method_name   = view(m_method_name);
+        request.target        = view(m_target);
+        request.version_minor = m_version_minor;
+        request.field_count   = m_field_count;
+        request.body          = {};
+        for (std::size_t i = 0; i < m_field_count; ++i) {
+            request.fields[i] = { m_fields[i].id, view(m_fields[i].name), view(m_fields[i].value) };
+        }
+    }
+} // namespace http
@@ -0,0 +1,113 @@
+#ifndef HTTP_REQUEST_PARSER_H
+#define HTTP_REQUEST_PARSER_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "http/headers.h"
+
+namespace http {
+    constexpr std::size_t kMaxHeaders  = 64;        // Header fields accepted per request
+    constexpr std::size_t kMaxHeadSize = 16 * 1024; // Request line plus header block, in bytes
+
+    enum class Method : uint8_t { get, head, post, put, delete_, connect, options, trace, patch, unknown };
+
+    struct Header {
+        headers::Id id {headers::Id::unknown}; //!< Resolved identifier, unknown for unregistered names
+        std::string_view name;                 //!< Name as received, without the colon
+        std::string_view value;                //!< Value without leading and trailing whitespace
+    };
+
+    /**
+     * A parsed request head. Every view points into the buffer given to RequestParser::parse()
+     * and is only valid while that buffer is alive and unmodified.
+     */
+    struct Request {
+        Method method {Method::unknown};
+        std::string_view method_name;
+        std::string_view target;
+        uint8_t version_minor {1}; //!< 0 for HTTP/1.0, 1 for HTTP/1.1
+        std::array<Header, kMaxHeaders> fields;
+        std::size_t field_count {0};
+        std::string_view body; //!< Filled in by the connection once the whole body has arrived
+
+        /**
+         * @brief Value of the first field with the given identifier
+         * @param[in] id    Header identifier
+         * @return The field value or an empty view when the header is absent
+         */
+        std::string_view header(headers::Id id) const;
+
+        /**
+         * @brief Whether the connection may stay open after this request, from the protocol
+         * version and the connection header (HTTP/1.1 defaults to persistent connections)
+         */
+        bool keepAlive() const;
+    };
+
+    enum class ParseResult : uint8_t {
+        complete,   //!< The head was parsed, the body (if any) starts at consumed()
+        incomplete, //!< More bytes are needed, call parse() again once they arrive
+        invalid,    //!< The request is malformed and should be answered with 400
+        too_large   //!< The head exceeds kMaxHeadSize or kMaxHeaders (431)
+    };
+
+    /**
+     * Incremental HTTP/1.1 request head parser. It never copies or allocates: progress is kept
+     * as offsets, so the caller may grow or move its receive buffer between partial reads as
+     * long as the bytes already received stay at the front. Lines that were fully parsed are
+     * not scanned again.
+     */
+    class RequestParser {
+    public:
+        /**
+         * @brief Parses as much of the request head as the buffer holds
+         * @param[in]  buffer     Bytes received so far, starting at the request line
+         * @param[out] request    Filled in when the result is ParseResult::complete
+         */
+        ParseResult parse(std::string_view buffer, Request& request);
+
+        /**
+         * @brief Size of the request head, valid after a complete parse
+         */
+        std::size_t consumed() const {
+            return m_position;
+        }
+
+        /**
+         * @brief Prepares the parser for the next request on the same connection
+         */
+        void reset();
+
+    private:
+        enum class State : uint8_t { request_line, fields, done };
+
+        struct Span {
+            uint32_t offset {0};
+            uint32_t length {0};
+        };
+
+        struct Field {
+            headers::Id id {headers::Id::unknown};
+            Span name;
+            Span value;
+        };
+
+        State m_state {State::request_line};
+        std::size_t m_position {0}; // Start of the first line that was not parsed yet
+        Method m_method {Method::unknown};
+        Span m_method_name;
+        Span m_target;
+        uint8_t m_version_minor {1};
+        std::array<Field, kMaxHeaders> m_fields;
+        std::size_t m_field_count {0};
+
+        ParseResult parseRequestLine(const char* buffer, const char* end);
+        ParseResult parseField(const char* buffer, const char* end);
+        void fill(const char* buffer, Request& request) const;
+    };
+} // namespace http
+
+#endif // define HTTP_REQUEST_PARSER_H
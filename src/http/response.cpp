@@ -0,0 +1,78 @@
+#include "http/response.h"
+
+#include "constants.h"
+#include "http/field_value.h"
+#include "utils/utils.h"
+
+namespace http {
+    namespace {
+        void appendField(memory::Buffer& out, const std::string_view name, const std::string_view value) {
+            Utils::append(out, name, ": ", value, "\r\n");
+        }
+    } // namespace
+
+    std::string_view reasonPhrase(const uint16_t status) {
+        switch (status) {
+            case 100: return "Continue";
+            case 200: return "OK";
+            case 201: return "Created";
+            case 204: return "No Content";
+            case 206: return "Partial Content";
+            case 301: return "Moved Permanently";
+            case 302: return "Found";
+            case 304: return "Not Modified";
+            case 400: return "Bad Request";
+            case 403: return "Forbidden";
+            case 404: return "Not Found";
+            case 405: return "Method Not Allowed";
+            case 408: return "Request Timeout";
+            case 411: return "Length Required";
+            case 412: return "Precondition Failed";
+            case 413: return "Payload Too Large";
+            case 416: return "Range Not Satisfiable";
+            case 431: return "Request Header Fields Too Large";
+            case 500: return "Internal Server Error";
+            case 501: return "Not Implemented";
+            case 503: return "Service Unavailable";
+            case 505: return "HTTP Version Not Supported";
+            default: return {};
+        }
+    }
+
+    void serializeHead(const Response& response, const std::string_view date, memory::Buffer& out, const std::string_view omit) {
+        Utils::append(out, response.status, ' ', reasonPhrase(response.status), "\r\n");
+
+        appendField(out, headers::other::date, date);
+        appendField(out, headers::response_contex::server, "sagan");
+        for (const auto& field : response.fields) {
+            if (omit.empty() || !equalsIgnoreCase(field.first, omit)) appendField(out, field.first, field.second);
+        }
+
+        if (allowsBody(response.status) && response.chunked) {
+            appendField(out, headers::transfer_coding::transfer_encoding, "chunked");
+        } else if (allowsBody(response.status)) {
+            const uint64_t length = response.file.fd >= 0 ? response.file.length : response.body.size();
+            Utils::append(out, headers::body_information::content_length, ": ", length, "\r\n");
+        }
+    }
+
+    void serializeFraming(const Framing& framing, memory::Buffer& out) {
+        if (!framing.keep_alive) {
+            appendField(out, headers::connection_management::connection, "close");
+        } else if (framing.version_minor == 0) {
+            appendField(out, headers::connection_management::connection, "keep-alive");
+            Utils::append(out, headers::connection_management::keep_alive, ": timeout=", framing.keep_alive_timeout, "\r\n");
+        }
+        if (!framing.server_timing.empty()) appendField(out, headers::other::server_timing, framing.server_timing);
+        out.append("\r\n");
+    }
+
+    void serialize(const Response& response, const Framing& framing, memory::Buffer& out) {
+        out.append(statusPrefix(framing.version_minor));
+        serializeHead(response, framing.date, out);
+        serializeFraming(framing, out);
+
+        // File bodies are written by the connection after the head, see FileRange
+        if (!framing.head && allowsBody(response.status) && response.file.fd < 0) out.append(std::string_view(response.body));
+    }
+} // namespace http
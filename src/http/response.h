@@ -0,0 +1,119 @@
+#ifndef HTTP_RESPONSE_H
+#define HTTP_RESPONSE_H
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "http/request_parser.h"
+#include "memory/arena.h"
+#include "memory/buffer.h"
+
+namespace http {
+    /**
+     * Body sent straight from a file with sendfile(), without copying it through user space.
+     * owner keeps the descriptor open until the range has been written to the socket.
+     */
+    struct FileRange {
+        std::shared_ptr<const void> owner;
+        int fd {-1};
+        uint64_t offset {0};
+        uint64_t length {0};
+    };
+
+    /**
+     * Response built by a handler. Header values and the body live in the arena of the
+     * connection and are released together once the response has been serialised. Framing
+     * headers (date, content-length, connection) are added by serialize() and must not be set here.
+     */
+    struct Response {
+        using Field = std::pair<std::string_view, std::string_view>;
+
+        explicit Response(memory::Arena& arena) :
+            fields(memory::ArenaAllocator<Field>(arena)), body(memory::ArenaAllocator<char>(arena)), m_arena(&arena) {}
+
+        uint16_t status {200};
+        std::vector<Field, memory::ArenaAllocator<Field>> fields;
+        memory::ArenaString body;
+        FileRange file; //!< Replaces body when file.fd is set
+        bool chunked {false}; //!< Body framed with the chunked transfer coding, see compressResponse()
+
+        /**
+         * @brief Adds a header, copying the value into the arena
+         * @param[in] name     Header name, must outlive the response (usually from constants.h)
+         * @param[in] value    Header value
+         */
+        void set(const std::string_view name, const std::string_view value) {
+            fields.emplace_back(name, m_arena->copy(value));
+        }
+
+        /**
+         * @brief Arena of the request, for handler allocations that live as long as the response
+         */
+        memory::Arena& arena() const {
+            return *m_arena;
+        }
+
+    private:
+        memory::Arena* m_arena;
+    };
+
+    using Handler = std::function<void(const Request&, Response&)>;
+
+    //! Connection level information needed to frame a response
+    struct Framing {
+        std::string_view date;           //!< Preformatted value of the date header
+        bool keep_alive {true};          //!< False adds "connection: close"
+        bool head {false};               //!< Response to HEAD, the body is left out
+        uint8_t version_minor {1};       //!< HTTP/1.0 clients need an explicit keep-alive
+        uint32_t keep_alive_timeout {0}; //!< Advertised in the keep-alive header, in seconds
+        std::string_view server_timing;  //!< Value of the server-timing header, left out when empty
+    };
+
+    /**
+     * @brief 1xx, 204 and 304 responses never carry a body (RFC 7230, 3.3.2)
+     */
+    constexpr bool allowsBody(const uint16_t status) {
+        return status >= 200 && status != 204 && status != 304;
+    }
+
+    /**
+     * @brief Reason phrase for a status code, empty for unknown codes
+     */
+    std::string_view reasonPhrase(uint16_t status);
+
+    /**
+     * @brief Start of the status line, up to the status code
+     */
+    constexpr std::string_view statusPrefix(const uint8_t version_minor) {
+        return version_minor == 0 ? "HTTP/1.0 " : "HTTP/1.1 ";
+    }
+
+    /**
+     * @brief Appends the part of a response head that does not depend on the connection: the
+     * status line after statusPrefix(), date, server, the handler's fields and content-length
+     * @param[in]  response    Response produced by the handler
+     * @param[in]  date        Preformatted value of the date header
+     * @param[out] out         Output buffer
+     * @param[in]  omit        Name of a handler field to leave out
+     */
+    void serializeHead(const Response& response, std::string_view date, memory::Buffer& out, std::string_view omit = {});
+
+    /**
+     * @brief Appends the connection headers and the empty line that ends the head
+     */
+    void serializeFraming(const Framing& framing, memory::Buffer& out);
+
+    /**
+     * @brief Appends the status line, headers and body of a response to out
+     * @param[in]  response    Response produced by the handler
+     * @param[in]  framing     Connection state used for the framing headers
+     * @param[out] out         Output buffer of the connection
+     */
+    void serialize(const Response& response, const Framing& framing, memory::Buffer& out);
+} // namespace http
+
+#endif // define HTTP_RESPONSE_H
@@ -0,0 +1,397 @@
+#include "http/response_cache.h"
+
+#include <charconv>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <utility>
+
+#include "constants.h"
+#include "http/date.h"
+#include "http/field_value.h"
+#include "http/headers.h"
+#include "utils/utils.h"
+
+namespace http {
+    namespace {
+        constexpr std::size_t kShards      = 64; // Power of two, well above the usual reactor count
+        constexpr std::size_t kMaxVariants = 4;  // Responses kept per key when they vary
+        constexpr std::size_t kMaxObjectShare = 8; // A response may take up to 1/8 of the capacity
+
+        struct Directives {
+            bool no_store {false};
+            bool no_cache {false};
+            bool is_private {false};
+            bool must_revalidate {false};
+            int64_t max_age {-1};
+            int64_t s_maxage {-1};
+            int64_t stale_while_revalidate {-1};
+        };
+
+        bool parseSeconds(std::string_view value, int64_t& seconds) {
+            if (value.size() >= 2 && value.front() == '"' && value.back() == '"') value = value.substr(1, value.size() - 2);
+            if (value.empty()) return false;
+            const auto result = std::from_chars(value.data(), value.data() + value.size(), seconds);
+            return result.ec == std::errc() && result.ptr == value.data() + value.size() && seconds >= 0;
+        }
+
+        //! Cache-control directives of a request or a response (RFC 7234, 5.2 and RFC 5861)
+        Directives parseCacheControl(const std::string_view value) {
+            Directives directives;
+            forEachListItem(value, [&](const std::string_view item) {
+                const std::size_t equals        = item.find('=');
+                const std::string_view name     = trim(item.substr(0, equals));
+                const std::string_view argument = equals == std::string_view::npos ? std::string_view() : trim(item.substr(equals + 1));
+                int64_t seconds                 = 0;
+                if (equalsIgnoreCase(name, "no-store")) {
+                    directives.no_store = true;
+                } else if (equalsIgnoreCase(name, "no-cache")) {
+                    directives.no_cache = true;
+                } else if (equalsIgnoreCase(name, "private")) {
+                    directives.is_private = true;
+                } else if (equalsIgnoreCase(name, "must-revalidate") || equalsIgnoreCase(name, "proxy-revalidate")) {
+                    directives.must_revalidate = true;
+                } else if (equalsIgnoreCase(name, "max-age") && parseSeconds(argument, seconds)) {
+                    directives.max_age = seconds;
+                } else if (equalsIgnoreCase(name, "s-maxage") && parseSeconds(argument, seconds)) {
+                    directives.s_maxage = seconds;
+                } else if (equalsIgnoreCase(name, "stale-while-revalidate") && parseSeconds(argument, seconds)) {
+                    directives.stale_while_revalidate = seconds;
+                }
+                return true;
+            });
+            return directives;
+        }
+
+        std::string_view requestField(const Request& request, const std::string_view name) {
+            const headers::Id id = headers::lookup(name);
+            if (id != headers::Id::unknown) return request.header(id);
+            for (std::size_t i = 0; i < request.field_count; ++i) {
+                if (equalsIgnoreCase(request.fields[i].name, name)) return request.fields[i].value;
+            }
+            return {};
+        }
+
+        //! Statuses cacheable by default (RFC 7231, 6.1), partial content aside
+        bool cacheableStatus(const uint16_t status) {
+            switch (status) {
+                case 200: case 203: case 204: case 300: case 301: case 404: case 405: case 410: case 414: case 501: return true;
+                default: return false;
+            }
+        }
+
+        bool conditional(const Request& request) {
+            for (const headers::Id id : {headers::Id::if_match, headers::Id::if_none_match, headers::Id::if_modified_since,
+                                         headers::Id::if_unmodified_since, headers::Id::if_range}) {
+                if (!request.header(id).empty()) return true;
+            }
+            return false;
+        }
+
+        /**
+         * Key of a request, "host target" with the host lowercased, as a reverse proxy keys on
+         * the URL. Built in a per-thread buffer so that lookups do not allocate.
+         */
+        std::string_view cacheKey(const Request& request) {
+            thread_local std::string key;
+            key.assign(request.header(headers::Id::host));
+            for (char& c : key) c = static_cast<char>(toLower(static_cast<uint8_t>(c)));
+            key += ' '; // Neither a host nor a target can hold a space
+            key.append(request.target);
+            return key;
+        }
+
+        //! Whether a request asks to bypass stored responses, or to keep its response out of caches
+        bool bypasses(const Request& request, const Directives& directives) {
+            if (directives.no_store || directives.no_cache) return true;
+            if (!request.header(headers::Id::authorization).empty()) return true;
+
+            // Pragma only counts when cache-control is absent (RFC 7234, 5.4)
+            bool no_cache = false;
+            if (request.header(headers::Id::cache_control).empty()) {
+                forEachListItem(request.header(headers::Id::pragma), [&](const std::string_view item) {
+                    no_cache = equalsIgnoreCase(item, "no-cache");
+                    return !no_cache;
+                });
+            }
+            return no_cache;
+        }
+    } // namespace
+
+    std::size_t CachedResponse::bytes() const {
+        std::size_t total = sizeof(CachedResponse) + head.size() + body.size();
+        for (const std::string& value : vary_values) total += sizeof(std::string) + value.size();
+        return total;
+    }
+
+    /**
+     * One slice of the key space. Slots live in a deque so that index keys can view
+     * Slot::key while slots are added; freed slots are reused in place.
+     */
+    struct alignas(64) ResponseCache::Shard {
+        struct Slot {
+            std::string key; //!< See cacheKey(), empty when the slot is free
+            std::vector<std::string> vary;
+            std::vector<std::shared_ptr<const CachedResponse>> variants;
+            std::size_t bytes {0};
+        };
+
+        mutable std::shared_mutex mutex;
+        std::deque<Slot> slots;
+        std::vector<std::size_t> free;
+        std::unordered_map<std::string_view, std::size_t> index;
+        std::size_t hand {0};
+        std::size_t bytes {0};                     //!< Held by this shard
+        std::atomic<std::size_t>* total {nullptr}; //!< Held by the whole cache, see ResponseCache::m_bytes
+
+        void charge(const std::size_t size) {
+            bytes += size;
+            total->fetch_add(size, std::memory_order_relaxed);
+        }
+
+        void release(const std::size_t size) {
+            bytes -= size;
+            total->fetch_sub(size, std::memory_order_relaxed);
+        }
+
+        void drop(Slot& slot, const std::size_t variant) {
+            const std::size_t size = slot.variants[variant]->bytes();
+            slot.bytes -= size;
+            release(size);
+            slot.variants.erase(slot.variants.begin() + static_cast<std::ptrdiff_t>(variant));
+        }
+
+        void evict(const std::size_t position) {
+            Slot& slot = slots[position];
+            index.erase(slot.key);
+            release(slot.bytes);
+            slot = Slot {};
+            free.push_back(position);
+        }
+
+        /**
+         * CLOCK sweep: a slot read since the hand last passed gets a second chance, the others
+         * are evicted until needed more bytes fit in the whole cache. New entries start
+         * unreferenced, so responses requested only once leave before the ones that are hit.
+         * The slot being written to is skipped.
+         * @return False if this shard cannot free enough
+         */
+        bool makeRoom(const std::size_t needed, const std::size_t capacity, const std::size_t keep) {
+            for (std::size_t steps = 0; total->load(std::memory_order_relaxed) + needed > capacity; ++steps) {
+                if (steps > 2 * slots.size()) return false;
+                if (hand >= slots.size()) hand = 0;
+
+                const std::size_t position = hand++;
+                Slot& slot                 = slots[position];
+                if (position == keep || slot.key.empty()) continue;
+
+                bool referenced = false;
+                for (const auto& variant : slot.variants) {
+                    referenced |= variant->referenced.exchange(false, std::memory_order_relaxed);
+                }
+                if (!referenced) evict(position);
+            }
+            return true;
+        }
+    };
+
+    ResponseCache::ResponseCache(const std::size_t capacity) :
+        m_shards(new Shard[kShards]), m_capacity(capacity) {
+        for (std::size_t i = 0; i < kShards; ++i) m_shards[i].total = &m_bytes;
+    }
+
+    ResponseCache::~ResponseCache() = default;
+
+    ResponseCache::Shard& ResponseCache::shardOf(const std::string_view key) const {
+        return m_shards[std::hash<std::string_view> {}(key) & (kShards - 1)];
+    }
+
+    void ResponseCache::makeRoom(const std::size_t needed) {
+        // The hand moves round the shards so that the budget is shared by all of them; only one
+        // shard lock is held at a time, concurrent stores cannot deadlock
+        for (std::size_t visited = 0; visited < kShards && m_bytes.load(std::memory_order_relaxed) + needed > m_capacity; ++visited) {
+            Shard& shard = m_shards[m_hand.fetch_add(1, std::memory_order_relaxed) & (kShards - 1)];
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            shard.makeRoom(needed, m_capacity, SIZE_MAX);
+        }
+    }
+
+    CacheLookup ResponseCache::find(const Request& request, const std::time_t now) {
+        if (request.method != Method::get && request.method != Method::head) return {};
+
+        const Directives directives = parseCacheControl(request.header(headers::Id::cache_control));
+        if (bypasses(request, directives)) return {};
+        const bool validates = conditional(request);
+
+        const std::string_view key = cacheKey(request);
+        Shard& shard               = shardOf(key);
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+
+        const auto found = shard.index.find(key);
+        if (found == shard.index.end()) return {};
+
+        const Shard::Slot& slot = shard.slots[found->second];
+        for (const auto& variant : slot.variants) {
+            bool matches = true;
+            for (std::size_t i = 0; i < slot.vary.size() && matches; ++i) {
+                matches = requestField(request, slot.vary[i]) == variant->vary_values[i];
+            }
+            if (!matches) continue;
+            if (variant->chunked && request.version_minor == 0) return {};
+            if (validates && variant->status != 200) return {}; // Only a 200 can stand in for a 304 or 412
+
+            const std::time_t age = variant->age(now);
+            if (directives.max_age >= 0 && age > directives.max_age) return {};
+            if (age >= variant->lifetime + variant->stale_while_revalidate) return {};
+
+            // Only written when clear, hits on a hot entry leave its cache line shared
+            if (!variant->referenced.load(std::memory_order_relaxed)) {
+                variant->referenced.store(true, std::memory_order_relaxed);
+            }
+
+            CacheLookup lookup {variant, false};
+            if (age >= variant->lifetime) {
+                lookup.revalidate = !variant->revalidating.exchange(true, std::memory_order_relaxed);
+            }
+            return lookup;
+        }
+        return {};
+    }
+
+    void ResponseCache::store(const Request& request, const Response& response, const std::string_view date, const std::time_t now) {
+        if (request.method != Method::get || response.file.fd >= 0) return;
+        if (!cacheableStatus(response.status)) return;
+        if (parseCacheControl(request.header(headers::Id::cache_control)).no_store) return;
+        if (!request.header(headers::Id::authorization).empty()) return;
+
+        Directives directives;
+        std::vector<std::string> names;
+        bool any = false;
+        std::string_view expires;
+        std::string_view age;
+        for (const auto& field : response.fields) {
+            if (equalsIgnoreCase(field.first, headers::caching::cache_control)) {
+                directives = parseCacheControl(field.second);
+            } else if (equalsIgnoreCase(field.first, headers::conditionals::vary)) {
+                forEachListItem(field.second, [&](const std::string_view name) {
+                    any = name == "*";
+                    names.emplace_back(name);
+                    for (char& c : names.back()) c = static_cast<char>(toLower(static_cast<uint8_t>(c)));
+                    return !any;
+                });
+            } else if (equalsIgnoreCase(field.first, headers::caching::expires)) {
+                expires = field.second;
+            } else if (equalsIgnoreCase(field.first, headers::caching::age)) {
+                age = field.second;
+            } else if (equalsIgnoreCase(field.first, headers::cookies::set_cookie)) {
+                return; // Never share one client's cookies with another
+            }
+        }
+        if (directives.no_store || directives.no_cache || directives.is_private) return;
+
+        // s-maxage wins over max-age in a shared cache, both over expires (RFC 7234, 4.2.1)
+        int64_t lifetime = -1;
+        std::time_t expiry = 0;
+        if (directives.s_maxage >= 0) {
+            lifetime = directives.s_maxage;
+        } else if (directives.max_age >= 0) {
+            lifetime = directives.max_age;
+        } else if (!expires.empty()) {
+            lifetime = parseDate(expires, expiry) && expiry > now ? expiry - now : 0;
+        }
+        const int64_t stale = directives.must_revalidate ? 0 : std::max<int64_t>(directives.stale_while_revalidate, 0);
+        if (lifetime < 0 || lifetime + stale == 0) return;
+
+        if (any) return;
+
+        auto cached = std::make_shared<CachedResponse>();
+        {
+            // The handler's age becomes the initial age, serializeCached() writes the current one
+            memory::Buffer head;
+            serializeHead(response, date, head, headers::caching::age);
+            cached->head.assign(head.view());
+        }
+        cached->body.assign(response.body.data(), response.body.size());
+        for (const std::string& name : names) cached->vary_values.emplace_back(requestField(request, name));
+        cached->status   = response.status;
+        cached->chunked  = response.chunked;
+        cached->stored   = now;
+        cached->lifetime = static_cast<std::time_t>(lifetime);
+        cached->stale_while_revalidate = static_cast<std::time_t>(stale);
+        int64_t initial_age = 0;
+        if (parseSeconds(trim(age), initial_age)) cached->initial_age = static_cast<std::time_t>(initial_age);
+
+        const std::size_t size     = cached->bytes();
+        const std::string_view key = cacheKey(request);
+        if (size + key.size() > m_capacity / kMaxObjectShare) return;
+        makeRoom(size + key.size());
+
+        Shard& shard = shardOf(key);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+
+        std::size_t position = SIZE_MAX;
+        const auto found     = shard.index.find(key);
+        if (found != shard.index.end()) {
+            position            = found->second;
+            Shard::Slot& slot   = shard.slots[position];
+            if (slot.vary != names) {
+                while (!slot.variants.empty()) shard.drop(slot, 0);
+                slot.vary = names;
+            }
+            for (std::size_t i = 0; i < slot.variants.size(); ++i) {
+                if (slot.variants[i]->vary_values == cached->vary_values) {
+                    shard.drop(slot, i);
+                    break;
+                }
+            }
+            if (slot.variants.size() >= kMaxVariants) shard.drop(slot, 0);
+        }
+
+        const std::size_t needed = size + (position == SIZE_MAX ? key.size() : 0);
+        if (!shard.makeRoom(needed, m_capacity, position)) return; // Lost a race with other stores
+
+        if (position == SIZE_MAX) {
+            if (shard.free.empty()) {
+                position = shard.slots.size();
+                shard.slots.emplace_back();
+            } else {
+                position = shard.free.back();
+                shard.free.pop_back();
+            }
+            Shard::Slot& slot = shard.slots[position];
+            slot.key.assign(key);
+            slot.vary  = std::move(names);
+            slot.bytes = key.size();
+            shard.charge(slot.bytes);
+            shard.index.emplace(slot.key, position);
+        }
+
+        Shard::Slot& slot = shard.slots[position];
+        slot.variants.push_back(std::move(cached));
+        slot.bytes += size;
+        shard.charge(size);
+    }
+
+    std::size_t ResponseCache::size() const {
+        std::size_t total = 0;
+        for (std::size_t i = 0; i < kShards; ++i) {
+            std::shared_lock<std::shared_mutex> lock(m_shards[i].mutex);
+            total += m_shards[i].bytes;
+        }
+        return total;
+    }
+
+    void serializeCachedFraming(const CachedResponse& cached, const Framing& framing, const std::time_t now, memory::Buffer& out) {
+        Utils::append(out, headers::caching::age, ": ", static_cast<uint64_t>(cached.age(now)), "\r\n");
+        serializeFraming(framing, out);
+    }
+
+    void serializeCached(const CachedResponse& cached, const Framing& framing, const std::time_t now, memory::Buffer& out) {
+        out.append(statusPrefix(framing.version_minor));
+        out.append(cached.head);
+        serializeCachedFraming(cached, framing, now, out);
+        if (!framing.head && allowsBody(cached.status)) out.append(cached.body);
+    }
+} // namespace http
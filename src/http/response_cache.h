@@ -0,0 +1,128 @@
+#ifndef HTTP_RESPONSE_CACHE_H
+#define HTTP_RESPONSE_CACHE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "http/request_parser.h"
+#include "http/response.h"
+#include "memory/buffer.h"
+
+namespace http {
+    /**
+     * A stored response. The head is kept serialised, so a hit is a few appends to the output
+     * buffer; only the age and the connection headers are written per request.
+     */
+    struct CachedResponse {
+        std::string head;                     //!< From the status code to content-length, see serializeHead()
+        std::string body;
+        std::vector<std::string> vary_values; //!< Request values of the fields named by vary
+        uint16_t status {200};
+        bool chunked {false};                 //!< Compressed body, only usable over HTTP/1.1
+        std::time_t stored {0};               //!< When the response was produced
+        std::time_t initial_age {0};          //!< Age the handler reported, if any
+        std::time_t lifetime {0};             //!< Freshness lifetime in seconds
+        std::time_t stale_while_revalidate {0};
+
+        mutable std::atomic<bool> referenced {false};   //!< CLOCK reference bit, set by hits
+        mutable std::atomic<bool> revalidating {false}; //!< A reactor is already refreshing it
+
+        std::time_t age(const std::time_t now) const {
+            return initial_age + (now > stored ? now - stored : 0);
+        }
+
+        //! Memory charged against the cache capacity
+        std::size_t bytes() const;
+    };
+
+    struct CacheLookup {
+        std::shared_ptr<const CachedResponse> response; //!< nullptr on a miss
+        bool revalidate {false}; //!< Stale: the caller should refresh the entry with store()
+    };
+
+    /**
+     * Shared cache of handler responses, in front of the handler like a reverse proxy. Only
+     * GET responses are stored and HEAD is answered from them, so entries are keyed on the
+     * host and the request target (the URL) plus the request fields named by the response's
+     * vary header.
+     *
+     * Freshness comes from cache-control (s-maxage, max-age), expires and age; only statuses
+     * cacheable by default are stored, and conditional requests are only answered from a 200.
+     * Responses without an explicit lifetime, with no-store, no-cache or private, with set-cookie or to
+     * requests carrying credentials are not stored. Stale entries within their
+     * stale-while-revalidate window are still served while one caller refreshes them.
+     *
+     * The keys are spread over shards with their own reader-writer lock: hits only take the
+     * shared side, so they do not block each other, but each still makes an atomic update to the
+     * shard lock and to the response reference count, which a very hot key bounces between cores.
+     * The byte capacity is shared by every shard; once it is reached, a store sweeps the shards in
+     * turn with CLOCK until the response fits. A response larger than an eighth of the capacity
+     * is never stored.
+     */
+    class ResponseCache {
+    public:
+        /**
+         * @param[in] capacity    Bytes of headers and bodies the cache may hold
+         */
+        explicit ResponseCache(std::size_t capacity);
+        ~ResponseCache();
+
+        ResponseCache(const ResponseCache&) = delete;
+        ResponseCache& operator=(const ResponseCache&) = delete;
+
+        /**
+         * @brief Finds a response usable for a request
+         * @param[in] request    GET or HEAD request
+         * @param[in] now        Current time, seconds since the epoch
+         */
+        CacheLookup find(const Request& request, std::time_t now);
+
+        /**
+         * @brief Stores a response if the request and the response allow it
+         * @param[in] request     The request the handler answered
+         * @param[in] response    The handler's response
+         * @param[in] date        Value of the date header the response was sent with
+         * @param[in] now         Current time, seconds since the epoch
+         */
+        void store(const Request& request, const Response& response, std::string_view date, std::time_t now);
+
+        //! Bytes currently held, summed over the shards
+        std::size_t size() const;
+
+    private:
+        struct Shard;
+
+        std::unique_ptr<Shard[]> m_shards;
+        std::size_t m_capacity;
+        std::atomic<std::size_t> m_bytes {0}; // Sum of the shards, only changed with a shard lock held
+        std::atomic<std::size_t> m_hand {0};  // Next shard swept when the cache is full
+
+        Shard& shardOf(std::string_view key) const;
+
+        //! Evicts from the shards in turn until needed more bytes fit, or each was swept once
+        void makeRoom(std::size_t needed);
+    };
+
+    /**
+     * @brief Appends the part of a cached response written per request: its current age, the
+     * connection headers and the empty line that ends the head
+     */
+    void serializeCachedFraming(const CachedResponse& cached, const Framing& framing, std::time_t now, memory::Buffer& out);
+
+    /**
+     * @brief Appends a cached response, with its current age, to out
+     * @param[in]  cached     Response found by ResponseCache::find()
+     * @param[in]  framing    Connection state used for the framing headers
+     * @param[in]  now        Current time, seconds since the epoch
+     * @param[out] out        Output buffer of the connection
+     */
+    void serializeCached(const CachedResponse& cached, const Framing& framing, std::time_t now, memory::Buffer& out);
+} // namespace http
+
+#endif // define HTTP_RESPONSE_CACHE_H
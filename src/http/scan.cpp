@@ -0,0 +1,187 @@
+#include "http/scan.h"
+
+#include <array>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define SAGAN_SCAN_X86 1
+#include <immintrin.h>
+#endif
+
+namespace http {
+    namespace scan {
+        namespace {
+            constexpr bool isLineEnd(const uint8_t c) {
+                return (c < 0x20 && c != '\t') || c == 0x7f;
+            }
+
+            constexpr bool isSpaceOrControl(const uint8_t c) {
+                return c <= 0x20 || c == 0x7f;
+            }
+
+            constexpr bool isToken(const uint8_t c) {
+                if ((c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z')) return true;
+                switch (c) {
+                    case '!': case '#': case '$': case '%': case '&': case '\'': case '*': case '+':
+                    case '-': case '.': case '^': case '_': case '`': case '|': case '~':
+                        return true;
+                    default:
+                        return false;
+                }
+            }
+
+            template <bool (*Predicate)(uint8_t)>
+            constexpr std::array<bool, 256> makeTable() {
+                std::array<bool, 256> table {};
+                for (std::size_t i = 0; i < table.size(); ++i) table[i] = Predicate(static_cast<uint8_t>(i));
+                return table;
+            }
+
+            constexpr std::array<bool, 256> kLineEnd        = makeTable<isLineEnd>();
+            constexpr std::array<bool, 256> kSpaceOrControl = makeTable<isSpaceOrControl>();
+            constexpr std::array<bool, 256> kToken          = makeTable<isToken>();
+
+            const char* scalarLineEnd(const char* begin, const char* end) {
+                while (begin != end && !kLineEnd[static_cast<uint8_t>(*begin)]) ++begin;
+                return begin;
+            }
+
+            const char* scalarSpaceOrControl(const char* begin, const char* end) {
+                while (begin != end && !kSpaceOrControl[static_cast<uint8_t>(*begin)]) ++begin;
+                return begin;
+            }
+
+            const char* scalarNonToken(const char* begin, const char* end) {
+                while (begin != end && kToken[static_cast<uint8_t>(*begin)]) ++begin;
+                return begin;
+            }
+
+#ifdef SAGAN_SCAN_X86
+            // PCMPESTRI range pairs, a match means the byte belongs to one of the ranges
+            alignas(16) constexpr char kLineEndRanges[16]        = "\x00\x08\x0a\x1f\x7f\x7f";
+            alignas(16) constexpr char kSpaceOrControlRanges[16] = "\x00\x20\x7f\x7f";
+            // '{' to 0xff also covers '|' and '~', which are tokens and get skipped afterwards
+            alignas(16) constexpr char kNonTokenRanges[16] = { '\x00', ' ', '"', '"', '(', ')', ',', ',',
+                                                               '/', '/', ':', '@', '[', ']', '{', '\xff' };
+
+            template <int RangesLength>
+            __attribute__((target("sse4.2"))) const char* sse42Find(const char* ranges_data,
+                                                                    const char* begin,
+                                                                    const char* end) {
+                const __m128i ranges = _mm_load_si128(reinterpret_cast<const __m128i*>(ranges_data));
+                while (end - begin >= 16) {
+                    const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+                    const int index    = _mm_cmpestri(ranges, RangesLength, data, 16,
+                                                   _SIDD_UBYTE_OPS | _SIDD_CMP_RANGES | _SIDD_LEAST_SIGNIFICANT);
+                    if (index != 16) return begin + index;
+                    begin += 16;
+                }
+                return begin;
+            }
+
+            __attribute__((target("sse4.2"))) const char* sse42LineEnd(const char* begin, const char* end) {
+                begin = sse42Find<6>(kLineEndRanges, begin, end);
+                return scalarLineEnd(begin, end);
+            }
+
+            __attribute__((target("sse4.2"))) const char* sse42SpaceOrControl(const char* begin, const char* end) {
+                begin = sse42Find<4>(kSpaceOrControlRanges, begin, end);
+                return scalarSpaceOrControl(begin, end);
+            }
+
+            __attribute__((target("sse4.2"))) const char* sse42NonToken(const char* begin, const char* end) {
+                for (;;) {
+                    begin = sse42Find<16>(kNonTokenRanges, begin, end);
+                    if (end - begin < 16) return scalarNonToken(begin, end);
+                    if (*begin != '|' && *begin != '~') return begin;
+                    ++begin;
+                }
+            }
+
+            __attribute__((target("avx2"))) const char* avx2LineEnd(const char* begin, const char* end) {
+                const __m256i max_control = _mm256_set1_epi8(0x1f);
+                const __m256i tab         = _mm256_set1_epi8('\t');
+                const __m256i del         = _mm256_set1_epi8(0x7f);
+                while (end - begin >= 32) {
+                    const __m256i data    = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin));
+                    const __m256i control = _mm256_cmpeq_epi8(_mm256_min_epu8(data, max_control), data);
+                    const __m256i matches = _mm256_or_si256(_mm256_andnot_si256(_mm256_cmpeq_epi8(data, tab), control),
+                                                            _mm256_cmpeq_epi8(data, del));
+                    const uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(matches));
+                    if (mask != 0) return begin + __builtin_ctz(mask);
+                    begin += 32;
+                }
+                return scalarLineEnd(begin, end);
+            }
+
+            __attribute__((target("avx2"))) const char* avx2SpaceOrControl(const char* begin, const char* end) {
+                const __m256i space = _mm256_set1_epi8(0x20);
+                const __m256i del   = _mm256_set1_epi8(0x7f);
+                while (end - begin >= 32) {
+                    const __m256i data    = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin));
+                    const __m256i matches = _mm256_or_si256(_mm256_cmpeq_epi8(_mm256_min_epu8(data, space), data),
+                                                            _mm256_cmpeq_epi8(data, del));
+                    const uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(matches));
+                    if (mask != 0) return begin + __builtin_ctz(mask);
+                    begin += 32;
+                }
+                return scalarSpaceOrControl(begin, end);
+            }
+#endif
+
+            Kernels selectKernels() {
+#ifdef SAGAN_SCAN_X86
+                __builtin_cpu_init();
+                if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("sse4.2")) {
+                    return { avx2LineEnd, avx2SpaceOrControl, sse42NonToken, Isa::avx2 };
+                }
+                if (__builtin_cpu_supports("sse4.2")) {
+                    return { sse42LineEnd, sse42SpaceOrControl, sse42NonToken, Isa::sse42 };
+                }
+#endif
+                return { scalarLineEnd, scalarSpaceOrControl, scalarNonToken, Isa::scalar };
+            }
+
+            const Kernels& kernels() {
+                static const Kernels selected = selectKernels();
+                return selected;
+            }
+        } // namespace
+
+        const char* findLineEnd(const char* begin, const char* end) {
+            return kernels().line_end(begin, end);
+        }
+
+        const char* findSpaceOrControl(const char* begin, const char* end) {
+            return kernels().space_or_control(begin, end);
+        }
+
+        const char* findNonToken(const char* begin, const char* end) {
+            return kernels().non_token(begin, end);
+        }
+
+        Isa activeIsa() {
+            return kernels().isa;
+        }
+
+        bool kernelsFor(const Isa isa, Kernels& kernels) {
+#ifdef SAGAN_SCAN_X86
+            __builtin_cpu_init();
+#endif
+            switch (isa) {
+                case Isa::scalar: kernels = { scalarLineEnd, scalarSpaceOrControl, scalarNonToken, Isa::scalar }; return true;
+#ifdef SAGAN_SCAN_X86
+                case Isa::sse42:
+                    if (!__builtin_cpu_supports("sse4.2")) return false;
+                    kernels = { sse42LineEnd, sse42SpaceOrControl, sse42NonToken, Isa::sse42 };
+                    return true;
+                case Isa::avx2:
+                    if (!__builtin_cpu_supports("avx2") || !__builtin_cpu_supports("sse4.2")) return false;
+                    kernels = { avx2LineEnd, avx2SpaceOrControl, sse42NonToken, Isa::avx2 };
+                    return true;
+#endif
+                default: return false;
+            }
+        }
+    } // namespace scan
+} // namespace http
@@ -0,0 +1,57 @@
+#ifndef HTTP_SCAN_H
+#define HTTP_SCAN_H
+
+namespace http {
+    /**
+     * Byte scanning kernels used by the request parser. Each function returns a pointer to the
+     * first matching byte in [begin, end), or end when there is none. The implementation is
+     * picked once at runtime from the instruction sets the CPU supports (AVX2, SSE4.2) with a
+     * scalar fallback, so the binary does not need to be built for a specific machine.
+     */
+    namespace scan {
+        enum class Isa { scalar, sse42, avx2 };
+
+        using Kernel = const char* (*)(const char*, const char*);
+
+        //! The three kernels built for one instruction set
+        struct Kernels {
+            Kernel line_end;
+            Kernel space_or_control;
+            Kernel non_token;
+            Isa isa;
+        };
+
+        /**
+         * @brief Finds the end of a header value
+         * @return First control character other than horizontal tab (usually the CR of the CRLF)
+         */
+        const char* findLineEnd(const char* begin, const char* end);
+
+        /**
+         * @brief Finds the end of a request target
+         * @return First space or control character
+         */
+        const char* findSpaceOrControl(const char* begin, const char* end);
+
+        /**
+         * @brief Finds the end of a method or header name
+         * @return First byte that is not an RFC 7230 tchar
+         */
+        const char* findNonToken(const char* begin, const char* end);
+
+        /**
+         * @brief Instruction set used by the selected kernels
+         */
+        Isa activeIsa();
+
+        /**
+         * @brief Kernels of a given instruction set instead of the selected ones, so that tests
+         * can compare each of them with the scalar kernels
+         * @param[out] kernels    Filled in when the function returns true
+         * @return False when the CPU or the build lacks the instruction set
+         */
+        bool kernelsFor(Isa isa, Kernels& kernels);
+    } // namespace scan
+} // namespace http
+
+#endif // define HTTP_SCAN_H
@@ -0,0 +1,255 @@
+#include "http/static_files.h"
+
+#include <cerrno>
+#include <charconv>
+#include <ctime>
+#include <utility>
+
+#include "constants.h"
+#include "http/compression.h"
+#include "http/date.h"
+#include "http/field_value.h"
+#include "memory/arena.h"
+#include "utils/utils.h"
+
+namespace http {
+    namespace {
+        struct MediaType {
+            std::string_view extension;
+            std::string_view type;
+        };
+
+        constexpr MediaType kMediaTypes[] = {
+            { "html", "text/html; charset=utf-8" },  { "htm", "text/html; charset=utf-8" },
+            { "css", "text/css; charset=utf-8" },    { "js", "text/javascript; charset=utf-8" },
+            { "mjs", "text/javascript; charset=utf-8" }, { "json", "application/json" },
+            { "txt", "text/plain; charset=utf-8" },  { "xml", "application/xml" },
+            { "svg", "image/svg+xml" },              { "png", "image/png" },
+            { "jpg", "image/jpeg" },                 { "jpeg", "image/jpeg" },
+            { "gif", "image/gif" },                  { "webp", "image/webp" },
+            { "avif", "image/avif" },                { "ico", "image/x-icon" },
+            { "mp4", "video/mp4" },                  { "webm", "video/webm" },
+            { "mp3", "audio/mpeg" },                 { "ogg", "audio/ogg" },
+            { "wav", "audio/wav" },                  { "woff", "font/woff" },
+            { "woff2", "font/woff2" },               { "pdf", "application/pdf" },
+            { "wasm", "application/wasm" },          { "zip", "application/zip" },
+            { "gz", "application/gzip" },
+        };
+
+        enum class RangeResult { none, satisfiable, unsatisfiable };
+
+        int hexValue(const char c) {
+            if (c >= '0' && c <= '9') return c - '0';
+            if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+            if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+            return -1;
+        }
+
+        /**
+         * Appends the percent-decoded path of a request target to out. Fails on malformed
+         * escapes, NUL bytes and ".." segments, which could escape the document root.
+         */
+        bool appendPath(const std::string_view target, memory::ArenaString& out) {
+            const std::string_view path = target.substr(0, target.find_first_of("?#"));
+            if (path.empty() || path.front() != '/') return false;
+
+            const std::size_t start = out.size();
+            for (std::size_t i = 0; i < path.size(); ++i) {
+                char c = path[i];
+                if (c == '%') {
+                    if (i + 2 >= path.size()) return false;
+                    const int high = hexValue(path[i + 1]);
+                    const int low  = hexValue(path[i + 2]);
+                    if (high < 0 || low < 0) return false;
+                    c = static_cast<char>(high * 16 + low);
+                    i += 2;
+                }
+                if (c == '\0') return false;
+                out.push_back(c);
+            }
+
+            const std::string_view decoded(out.data() + start, out.size() - start);
+            for (std::size_t dots = decoded.find("/.."); dots != std::string_view::npos;
+                 dots = decoded.find("/..", dots + 1)) {
+                if (dots + 3 == decoded.size() || decoded[dots + 3] == '/') return false;
+            }
+            return true;
+        }
+
+        bool parseNumber(const std::string_view digits, uint64_t& value) {
+            if (digits.empty()) return false;
+            const auto result = std::from_chars(digits.data(), digits.data() + digits.size(), value);
+            return result.ec == std::errc() && result.ptr == digits.data() + digits.size();
+        }
+
+        /**
+         * Parses a single byte range (RFC 7233, 2.1). Several ranges or a malformed value are
+         * reported as none, and the whole representation is sent instead.
+         */
+        RangeResult parseRange(const std::string_view value, const uint64_t size, uint64_t& first, uint64_t& last) {
+            constexpr std::string_view kUnit = "bytes=";
+            if (value.size() <= kUnit.size() || !equalsIgnoreCase(value.substr(0, kUnit.size()), kUnit)) {
+                return RangeResult::none;
+            }
+
+            const std::string_view spec = trim(value.substr(kUnit.size()));
+            const std::size_t dash      = spec.find('-');
+            if (dash == std::string_view::npos || spec.find(',') != std::string_view::npos) return RangeResult::none;
+
+            const std::string_view from = spec.substr(0, dash);
+            const std::string_view to   = spec.substr(dash + 1);
+            if (from.empty()) {
+                uint64_t suffix = 0;
+                if (!parseNumber(to, suffix)) return RangeResult::none;
+                if (suffix == 0 || size == 0) return RangeResult::unsatisfiable;
+                first = size - std::min(suffix, size);
+                last  = size - 1;
+                return RangeResult::satisfiable;
+            }
+
+            if (!parseNumber(from, first)) return RangeResult::none;
+            last = UINT64_MAX;
+            if (!to.empty() && !parseNumber(to, last)) return RangeResult::none;
+            if (last < first) return RangeResult::none;
+            if (first >= size) return RangeResult::unsatisfiable;
+            last = std::min(last, size - 1);
+            return RangeResult::satisfiable;
+        }
+
+        //! Entity tags compared weakly ignore the W/ prefix (RFC 7232, 2.3.2)
+        std::string_view opaqueTag(const std::string_view tag) {
+            return tag.substr(0, 2) == "W/" ? tag.substr(2) : tag;
+        }
+
+        bool matchesAny(const std::string_view list, const std::string_view etag, const bool weak) {
+            bool matched = false;
+            forEachListItem(list, [&](const std::string_view tag) {
+                if (tag == "*") {
+                    matched = true;
+                } else if (weak) {
+                    matched = opaqueTag(tag) == opaqueTag(etag);
+                } else {
+                    matched = tag == etag && tag.substr(0, 2) != "W/";
+                }
+                return !matched;
+            });
+            return matched;
+        }
+
+        //! If-Range holds either a strong entity tag or the exact last-modified date
+        bool rangeStillValid(const std::string_view condition, const CachedFile& file) {
+            if (condition.empty()) return true;
+            if (condition.front() == '"' || condition.substr(0, 2) == "W/") return condition == file.etag;
+            std::time_t date = 0;
+            return parseDate(condition, date) && date == file.modified;
+        }
+
+        void respondStatus(Response& response, const uint16_t status) {
+            response.status = status;
+            response.body.assign(reasonPhrase(status));
+        }
+    } // namespace
+
+    StaticFiles::StaticFiles(std::string root, const std::size_t cache_entries, const uint32_t revalidate,
+                             const bool precompressed) :
+        m_root(std::move(root)), m_cache(cache_entries, revalidate), m_precompressed(precompressed) {
+        while (!m_root.empty() && m_root.back() == '/') m_root.pop_back();
+    }
+
+    void StaticFiles::operator()(const Request& request, Response& response) {
+        namespace names = headers;
+
+        if (request.method != Method::get && request.method != Method::head) {
+            respondStatus(response, 405);
+            response.set(names::response_contex::allow, "GET, HEAD");
+            return;
+        }
+
+        memory::ArenaString path(memory::ArenaAllocator<char>(response.arena()));
+        path.append(m_root);
+        if (!appendPath(request.target, path)) return respondStatus(response, 400);
+        if (path.back() == '/') path.append("index.html");
+
+        const std::time_t now   = std::time(nullptr);
+        const bool compressible = m_precompressed && minimumCompressedSize(contentType(path)) != SIZE_MAX;
+        std::shared_ptr<const CachedFile> file;
+        int error = 0;
+        if (compressible && acceptsEncoding(request.header(names::Id::accept_encoding), Encoding::gzip)) {
+            path.append(".gz");
+            file = m_cache.get(path, now, error);
+            path.resize(path.size() - 3);
+        }
+
+        const bool encoded = file != nullptr;
+        if (!encoded) file = m_cache.get(path, now, error);
+        if (file == nullptr && error == EISDIR) {
+            path.append("/index.html");
+            file = m_cache.get(path, now, error);
+        }
+        if (file == nullptr) return respondStatus(response, error == EACCES || error == EPERM ? 403 : 404);
+
+        response.set(names::range_requests::accept_ranges, "bytes");
+        if (compressible) response.set(names::conditionals::vary, "accept-encoding");
+        response.set(names::conditionals::etag, file->etag);
+        response.set(names::conditionals::last_modified, file->lastModified());
+
+        // Preconditions in the order of RFC 7232, 6
+        std::time_t date                = 0;
+        const std::string_view if_match = request.header(names::Id::if_match);
+        if (!if_match.empty()) {
+            if (!matchesAny(if_match, file->etag, false)) return respondStatus(response, 412);
+        } else if (parseDate(request.header(names::Id::if_unmodified_since), date) && file->modified > date) {
+            return respondStatus(response, 412);
+        }
+
+        const std::string_view if_none_match = request.header(names::Id::if_none_match);
+        if (!if_none_match.empty()) {
+            if (matchesAny(if_none_match, file->etag, true)) return respondStatus(response, 304);
+        } else if (parseDate(request.header(names::Id::if_modified_since), date) && file->modified <= date) {
+            return respondStatus(response, 304);
+        }
+
+        response.set(names::body_information::content_type, contentType(path));
+        if (encoded) response.set(names::body_information::content_encoding, encodingName(Encoding::gzip));
+
+        uint64_t first                = 0;
+        uint64_t last                 = file->size == 0 ? 0 : file->size - 1;
+        RangeResult range             = RangeResult::none;
+        const std::string_view header = request.header(names::Id::range);
+        if (request.method == Method::get && !header.empty() &&
+            rangeStillValid(request.header(names::Id::if_range), *file)) {
+            range = parseRange(header, file->size, first, last);
+        }
+
+        char content_range[Utils::kMaxFormattedSize<uint64_t, char, uint64_t, char, uint64_t> + 6];
+        if (range == RangeResult::unsatisfiable) {
+            response.set(names::range_requests::content_range, Utils::format(content_range, "bytes */", file->size));
+            return respondStatus(response, 416);
+        }
+
+        uint64_t length = file->size;
+        if (range == RangeResult::satisfiable) {
+            response.set(names::range_requests::content_range,
+                         Utils::format(content_range, "bytes ", first, '-', last, '/', file->size));
+            response.status = 206;
+            length          = last - first + 1;
+        }
+
+        response.file.fd     = file->fd;
+        response.file.offset = first;
+        response.file.length = length;
+        response.file.owner  = std::move(file);
+    }
+
+    std::string_view contentType(const std::string_view path) {
+        const std::size_t dot   = path.rfind('.');
+        const std::size_t slash = path.rfind('/');
+        if (dot != std::string_view::npos && (slash == std::string_view::npos || dot > slash)) {
+            const std::string_view extension = path.substr(dot + 1);
+            for (const MediaType& media : kMediaTypes) {
+                if (equalsIgnoreCase(extension, media.extension)) return media.type;
+            }
+        }
+        return "application/octet-stream";
+    }
+} // namespace http
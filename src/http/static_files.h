@@ -0,0 +1,47 @@
+#ifndef HTTP_STATIC_FILES_H
+#define HTTP_STATIC_FILES_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "http/file_cache.h"
+#include "http/request_parser.h"
+#include "http/response.h"
+
+namespace http {
+    /**
+     * Handler serving a directory tree. Bodies are sent with sendfile(), single byte ranges are
+     * answered with 206 and the etag/last-modified validators with 304 or 412. When the client
+     * accepts gzip, a precompressed sibling ("app.js.gz" next to "app.js") is served instead
+     * of the file, with content-encoding: gzip and its own validators. Each reactor
+     * runs its own copy of the handler (see net::Server), so every thread has its own cache of
+     * open files and nothing is locked.
+     */
+    class StaticFiles {
+    public:
+        /**
+         * @param[in] root             Directory served as "/"
+         * @param[in] cache_entries    Open files kept per reactor
+         * @param[in] revalidate       Seconds a cached file is trusted without calling stat()
+         * @param[in] precompressed    Look for ".gz" siblings of compressible files
+         */
+        explicit StaticFiles(std::string root, std::size_t cache_entries = 1024, uint32_t revalidate = 5,
+                             bool precompressed = true);
+
+        void operator()(const Request& request, Response& response);
+
+    private:
+        std::string m_root;
+        FileCache m_cache;
+        bool m_precompressed;
+    };
+
+    /**
+     * @brief Media type for a file name, from its extension
+     */
+    std::string_view contentType(std::string_view path);
+} // namespace http
+
+#endif // define HTTP_STATIC_FILES_H
@@ -1,12 +1,89 @@
+#include <signal.h>
+#include <unistd.h>
+
+#include <cstdlib>
+#include <exception>
 #include <iostream>
-#include "utils/utils.h"
+#include <string>
+
+#include "constants.h"
+#include "http/response.h"
+#include "http/static_files.h"
+#include "net/server.h"
+
+namespace {
+    void usage(const char* program) {
+        std::cerr << "Usage: " << program << " [-p port] [-t threads] [-k keep-alive seconds] [-r root] [-c cache megabytes] [-z level] [-m path] [-s] [-a]\n"
+                  << "  -p    Port to listen on (default 8080)\n"
+                  << "  -t    Reactor threads, 0 uses every hardware thread (default 0)\n"
+                  << "  -k    Idle timeout of persistent connections (default 5)\n"
+                  << "  -r    Serve the files under this directory instead of the greeting\n"
+                  << "  -c    Size of the shared response cache in MiB, 0 disables it (default 0),\n"
+                  << "        responses larger than an eighth of it are not cached\n"
+                  << "  -z    Compress responses with gzip or deflate at this zlib level (1 to 9), 0 disables it (default 0)\n"
+                  << "  -m    Serve Prometheus metrics at this path to loopback clients, e.g. /metrics (default off)\n"
+                  << "  -s    Add a server-timing header with the parse and handle durations\n"
+                  << "  -a    Pin each reactor thread to its own CPU\n";
+    }
+
+    void hello(const http::Request&, http::Response& response) {
+        response.set(http::headers::body_information::content_type, "text/plain");
+        response.set(http::headers::caching::cache_control, "public, max-age=60");
+        response.body.assign("Hello from sagan\n");
+    }
+} // namespace
+
+int main(int argc, char* argv[]) {
+    net::Config config;
+    std::string root;
+
+    int option;
+    while ((option = getopt(argc, argv, "p:t:k:r:c:z:m:sah")) != -1) {
+        switch (option) {
+            case 'p': config.port = static_cast<uint16_t>(std::atoi(optarg)); break;
+            case 't': config.threads = static_cast<std::size_t>(std::atoi(optarg)); break;
+            case 'k': config.keep_alive_timeout = static_cast<uint32_t>(std::atoi(optarg)); break;
+            case 'r': root = optarg; break;
+            case 'c': config.cache_size = static_cast<std::size_t>(std::atol(optarg)) << 20; break;
+            case 'z':
+                config.compression_level = std::atoi(optarg);
+                if (config.compression_level < 0 || config.compression_level > 9) {
+                    std::cerr << "Compression level must be between 0 and 9\n";
+                    return EXIT_FAILURE;
+                }
+                break;
+            case 'm': config.metrics_path = optarg; break;
+            case 's': config.server_timing = true; break;
+            case 'a': config.pin_threads = true; break;
+            default: usage(argv[0]); return option == 'h' ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+
+    // Reactor threads inherit this mask, so the termination signals are only seen by sigwait below
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+    try {
+        http::Handler handler = hello;
+        if (!root.empty()) handler = http::StaticFiles(root);
+
+        net::Server server(config, handler);
+        server.start();
+        std::cout << "Listening on port " << server.port() << " with " << server.threads() << " reactors\n";
 
-int main() {
-    int arr_of_int[] = {1, 2, 3, 4};
-    std::string arr_of_string[] = {"This", "is", "an", "example"};
+        int received;
+        sigwait(&signals, &received);
+        std::cout << "Shutting down\n";
 
-    Utils::presentArray(std::cout, arr_of_int, 4);
-    Utils::presentArray(std::cout, arr_of_string, 4);
+        server.stop();
+        server.join();
+    } catch (const std::exception& error) {
+        std::cerr << error.what() << '\n';
+        return EXIT_FAILURE;
+    }
 
-    return 0;
+    return EXIT_SUCCESS;
 }
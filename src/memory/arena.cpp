@@ -0,0 +1,61 @@
+#include "memory/arena.h"
+
+#include <cstring>
+#include <new>
+
+#include "memory/buffer_pool.h"
+
+namespace memory {
+    Arena::~Arena() {
+        reset();
+    }
+
+    std::string_view Arena::copy(const std::string_view bytes) {
+        if (bytes.empty()) return {};
+        char* destination = static_cast<char*>(allocate(bytes.size(), 1));
+        std::memcpy(destination, bytes.data(), bytes.size());
+        return std::string_view(destination, bytes.size());
+    }
+
+    void Arena::reset() {
+        BufferPool& pool = BufferPool::local();
+        while (m_blocks != nullptr) {
+            Block* block = m_blocks;
+            m_blocks     = block->next;
+            if (block->pooled) {
+                pool.release(reinterpret_cast<char*>(block));
+            } else {
+                operator delete(block);
+            }
+        }
+        m_cursor = nullptr;
+        m_limit  = nullptr;
+    }
+
+    void* Arena::allocateSlow(const std::size_t size, const std::size_t alignment) {
+        const std::size_t worst_case = sizeof(Block) + alignment - 1 + size;
+
+        if (worst_case > kBufferSize) {
+            // Oversized allocations get their own block, linked behind the current one so that
+            // the remaining space of the current block still serves small allocations
+            Block* block = new (operator new(worst_case)) Block {nullptr, false};
+            if (m_blocks == nullptr) {
+                m_blocks = block;
+            } else {
+                block->next    = m_blocks->next;
+                m_blocks->next = block;
+            }
+            const auto start = reinterpret_cast<std::uintptr_t>(block + 1);
+            return reinterpret_cast<void*>((start + alignment - 1) & ~(alignment - 1));
+        }
+
+        char* memory = BufferPool::local().acquire();
+        m_blocks     = new (memory) Block {m_blocks, true};
+        m_cursor     = memory + sizeof(Block);
+        m_limit      = memory + kBufferSize;
+
+        const auto aligned = (reinterpret_cast<std::uintptr_t>(m_cursor) + alignment - 1) & ~(alignment - 1);
+        m_cursor           = reinterpret_cast<char*>(aligned + size);
+        return reinterpret_cast<void*>(aligned);
+    }
+} // namespace memory
@@ -0,0 +1,104 @@
+#ifndef MEMORY_ARENA_H
+#define MEMORY_ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace memory {
+    /**
+     * Bump allocator for everything that lives as long as one request: response headers,
+     * bodies and handler scratch data. Allocation is a pointer increment, deallocation does
+     * nothing and reset() frees everything at once. Blocks come from the thread's BufferPool,
+     * so an arena must be used and reset on a single thread.
+     */
+    class Arena {
+    public:
+        Arena() = default;
+        ~Arena();
+
+        Arena(const Arena&) = delete;
+        Arena& operator=(const Arena&) = delete;
+
+        /**
+         * @brief Allocates size bytes aligned to alignment, which must be a power of two
+         * @throws std::bad_alloc if a block larger than kBufferSize cannot be allocated
+         */
+        void* allocate(const std::size_t size, const std::size_t alignment = alignof(std::max_align_t)) {
+            const auto aligned = (reinterpret_cast<std::uintptr_t>(m_cursor) + alignment - 1) & ~(alignment - 1);
+            if (m_cursor != nullptr && aligned + size <= reinterpret_cast<std::uintptr_t>(m_limit)) {
+                m_cursor = reinterpret_cast<char*>(aligned + size);
+                return reinterpret_cast<void*>(aligned);
+            }
+            return allocateSlow(size, alignment);
+        }
+
+        /**
+         * @brief Copies bytes into the arena
+         * @return View over the copy, valid until reset()
+         */
+        std::string_view copy(std::string_view bytes);
+
+        /**
+         * @brief Releases every allocation and gives the blocks back to the pool
+         */
+        void reset();
+
+    private:
+        struct Block {
+            Block* next;
+            bool pooled; //!< Taken from the BufferPool, otherwise an oversized heap block
+        };
+
+        Block* m_blocks {nullptr}; // Most recent first
+        char* m_cursor {nullptr};
+        char* m_limit {nullptr};
+
+        void* allocateSlow(std::size_t size, std::size_t alignment);
+    };
+
+    /**
+     * Standard allocator over an Arena, so that containers can live in it. Memory is only
+     * reclaimed by Arena::reset(), containers must be destroyed before that.
+     */
+    template <typename T>
+    class ArenaAllocator {
+    public:
+        using value_type = T;
+
+        explicit ArenaAllocator(Arena& arena) noexcept :
+            m_arena(&arena) {}
+
+        template <typename U>
+        ArenaAllocator(const ArenaAllocator<U>& other) noexcept :
+            m_arena(other.arena()) {}
+
+        T* allocate(const std::size_t count) {
+            return static_cast<T*>(m_arena->allocate(count * sizeof(T), alignof(T)));
+        }
+
+        void deallocate(T*, std::size_t) noexcept {}
+
+        Arena* arena() const noexcept {
+            return m_arena;
+        }
+
+        template <typename U>
+        bool operator==(const ArenaAllocator<U>& other) const noexcept {
+            return m_arena == other.arena();
+        }
+
+        template <typename U>
+        bool operator!=(const ArenaAllocator<U>& other) const noexcept {
+            return m_arena != other.arena();
+        }
+
+    private:
+        Arena* m_arena;
+    };
+
+    using ArenaString = std::basic_string<char, std::char_traits<char>, ArenaAllocator<char>>;
+} // namespace memory
+
+#endif // define MEMORY_ARENA_H
@@ -0,0 +1,69 @@
+#include "memory/buffer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+#include "memory/buffer_pool.h"
+
+namespace memory {
+    Buffer::~Buffer() {
+        release();
+    }
+
+    void Buffer::reserve(const std::size_t minimum) {
+        if (tailSize() >= minimum) return;
+
+        const std::size_t length = size();
+        if (m_storage != nullptr && m_capacity - length >= minimum) {
+            // Enough room once the consumed prefix is reclaimed
+            std::memmove(m_storage, m_storage + m_begin, length);
+            m_begin = 0;
+            m_end   = length;
+            return;
+        }
+
+        const std::size_t required = length + minimum;
+        std::size_t capacity       = kBufferSize;
+        if (required > kBufferSize) capacity = std::max(required, m_capacity * 2);
+
+        char* storage = capacity == kBufferSize ? BufferPool::local().acquire()
+                                                : static_cast<char*>(operator new(capacity));
+        if (length > 0) std::memcpy(storage, m_storage + m_begin, length);
+        release();
+
+        m_storage  = storage;
+        m_capacity = capacity;
+        m_begin    = 0;
+        m_end      = length;
+    }
+
+    void Buffer::append(const std::string_view bytes) {
+        if (bytes.empty()) return;
+        if (tailSize() < bytes.size()) reserve(bytes.size());
+        std::memcpy(m_storage + m_end, bytes.data(), bytes.size());
+        m_end += bytes.size();
+    }
+
+    void Buffer::consume(const std::size_t length) {
+        m_begin += std::min(length, size());
+        if (m_begin == m_end) clear();
+    }
+
+    void Buffer::clear() {
+        release();
+        m_begin = 0;
+        m_end   = 0;
+    }
+
+    void Buffer::release() {
+        if (m_storage == nullptr) return;
+        if (m_capacity == kBufferSize) {
+            BufferPool::local().release(m_storage);
+        } else {
+            operator delete(m_storage);
+        }
+        m_storage  = nullptr;
+        m_capacity = 0;
+    }
+} // namespace memory
@@ -0,0 +1,88 @@
+#ifndef MEMORY_BUFFER_H
+#define MEMORY_BUFFER_H
+
+#include <cstddef>
+#include <string_view>
+
+namespace memory {
+    /**
+     * Growable byte buffer for socket I/O. Storage comes from the thread's BufferPool while the
+     * content fits in kBufferSize and from the heap beyond that. Bytes are consumed from the
+     * front by moving an offset, and the storage goes back to the pool as soon as the buffer is
+     * empty, so idle connections hold no memory.
+     */
+    class Buffer {
+    public:
+        Buffer() = default;
+        ~Buffer();
+
+        Buffer(const Buffer&) = delete;
+        Buffer& operator=(const Buffer&) = delete;
+
+        const char* data() const {
+            return m_storage + m_begin;
+        }
+
+        std::size_t size() const {
+            return m_end - m_begin;
+        }
+
+        bool empty() const {
+            return m_end == m_begin;
+        }
+
+        std::string_view view() const {
+            return std::string_view(data(), size());
+        }
+
+        /**
+         * @brief Free space after the content, at least minimum bytes once reserve() returns
+         */
+        char* tail() {
+            return m_storage + m_end;
+        }
+
+        std::size_t tailSize() const {
+            return m_capacity - m_end;
+        }
+
+        /**
+         * @brief Makes room for at least minimum bytes after the content
+         */
+        void reserve(std::size_t minimum);
+
+        /**
+         * @brief Marks length bytes written at tail() as content
+         */
+        void commit(std::size_t length) {
+            m_end += length;
+        }
+
+        void append(std::string_view bytes);
+
+        void append(const char c) {
+            if (m_end == m_capacity) reserve(1);
+            m_storage[m_end++] = c;
+        }
+
+        /**
+         * @brief Drops length bytes from the front, releasing the storage when nothing is left
+         */
+        void consume(std::size_t length);
+
+        /**
+         * @brief Drops the content and gives the storage back
+         */
+        void clear();
+
+    private:
+        char* m_storage {nullptr};
+        std::size_t m_capacity {0};
+        std::size_t m_begin {0};
+        std::size_t m_end {0};
+
+        void release();
+    };
+} // namespace memory
+
+#endif // define MEMORY_BUFFER_H
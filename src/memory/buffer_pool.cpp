@@ -0,0 +1,38 @@
+#include "memory/buffer_pool.h"
+
+#include <new>
+
+namespace memory {
+    BufferPool::~BufferPool() {
+        while (m_free != nullptr) {
+            Node* node = m_free;
+            m_free     = node->next;
+            operator delete(node);
+        }
+    }
+
+    char* BufferPool::acquire() {
+        if (m_free == nullptr) return static_cast<char*>(operator new(kBufferSize));
+
+        Node* node = m_free;
+        m_free     = node->next;
+        --m_cached;
+        return reinterpret_cast<char*>(node);
+    }
+
+    void BufferPool::release(char* buffer) {
+        if (m_cached == kMaxCachedBuffers) {
+            operator delete(buffer);
+            return;
+        }
+
+        Node* node = new (buffer) Node {m_free};
+        m_free     = node;
+        ++m_cached;
+    }
+
+    BufferPool& BufferPool::local() {
+        thread_local BufferPool pool;
+        return pool;
+    }
+} // namespace memory
@@ -0,0 +1,52 @@
+#ifndef MEMORY_BUFFER_POOL_H
+#define MEMORY_BUFFER_POOL_H
+
+#include <cstddef>
+
+namespace memory {
+    constexpr std::size_t kBufferSize       = 16 * 1024; // Size of every pooled buffer
+    constexpr std::size_t kMaxCachedBuffers = 1024;      // Per thread, extra releases are freed
+
+    /**
+     * Free list of fixed-size buffers. Each thread owns its pool (see local()), so acquiring
+     * and releasing never takes a lock and never touches malloc once the pool is warm. A buffer
+     * must be released on the thread that acquired it.
+     */
+    class BufferPool {
+    public:
+        BufferPool() = default;
+        ~BufferPool();
+
+        BufferPool(const BufferPool&) = delete;
+        BufferPool& operator=(const BufferPool&) = delete;
+
+        /**
+         * @brief Takes a buffer of kBufferSize bytes, from the free list when possible
+         */
+        char* acquire();
+
+        /**
+         * @brief Gives a buffer obtained from acquire() back to the pool
+         */
+        void release(char* buffer);
+
+        std::size_t cached() const {
+            return m_cached;
+        }
+
+        /**
+         * @brief Pool of the calling thread, destroyed (with its buffers) when the thread exits
+         */
+        static BufferPool& local();
+
+    private:
+        struct Node {
+            Node* next;
+        };
+
+        Node* m_free {nullptr};
+        std::size_t m_cached {0};
+    };
+} // namespace memory
+
+#endif // define MEMORY_BUFFER_POOL_H
@@ -0,0 +1,61 @@
+#include "metrics/histogram.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace metrics {
+    void Histogram::merge(const Histogram& other) {
+        for (std::size_t i = 0; i < kBucketCount; ++i) {
+            const uint64_t counted = load(other.m_counts[i]);
+            if (counted != 0) add(m_counts[i], counted);
+        }
+        add(m_count, load(other.m_count));
+        add(m_sum, load(other.m_sum));
+        m_min.store(std::min(load(m_min), load(other.m_min)), std::memory_order_relaxed);
+        m_max.store(std::max(load(m_max), load(other.m_max)), std::memory_order_relaxed);
+    }
+
+    void Histogram::reset() {
+        for (Cell& cell : m_counts) cell.store(0, std::memory_order_relaxed);
+        m_count.store(0, std::memory_order_relaxed);
+        m_sum.store(0, std::memory_order_relaxed);
+        m_min.store(UINT64_MAX, std::memory_order_relaxed);
+        m_max.store(0, std::memory_order_relaxed);
+    }
+
+    uint64_t Histogram::percentile(const double quantile) const {
+        // The total is taken from the buckets, a concurrent writer may be ahead in m_count
+        const uint64_t total = bucketTotal();
+        if (total == 0) return 0;
+
+        const double clamped = std::min(std::max(quantile, 0.0), 1.0);
+        const auto rank      = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(clamped * static_cast<double>(total))));
+        const uint64_t high  = max();
+        uint64_t seen        = 0;
+        for (std::size_t i = 0; i < kBucketCount; ++i) {
+            seen += load(m_counts[i]);
+            if (seen >= rank) return std::min(upperBound(i), high);
+        }
+        return high;
+    }
+
+    uint64_t Histogram::countAtOrBelow(const uint64_t value) const {
+        uint64_t seen = 0;
+        for (std::size_t i = 0; i < kBucketCount && upperBound(i) <= value; ++i) seen += load(m_counts[i]);
+        return seen;
+    }
+
+    uint64_t Histogram::bucketTotal() const {
+        uint64_t total = 0;
+        for (const Cell& cell : m_counts) total += load(cell);
+        return total;
+    }
+
+    uint64_t Histogram::upperBound(const std::size_t index) {
+        if (index < kSubBuckets) return index;
+        const uint64_t shift = index / kSubBuckets - 1;
+        const uint64_t sub   = index % kSubBuckets;
+        const uint64_t lower = (kSubBuckets + sub) << shift;
+        return lower + ((uint64_t {1} << shift) - 1);
+    }
+} // namespace metrics
@@ -0,0 +1,125 @@
+#ifndef METRICS_HISTOGRAM_H
+#define METRICS_HISTOGRAM_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace metrics {
+    /**
+     * Log-linear histogram in the style of HdrHistogram: every power of two is split into
+     * kSubBuckets linear buckets, so any value is kept within about 3% over the full
+     * uint64_t range with a fixed array and no allocation. Recording is a few instructions.
+     *
+     * A histogram has a single writer: record(), merge() and reset() must come from the thread
+     * that owns it. The cells are atomics updated with relaxed loads and stores rather than
+     * locked increments, so recording stays wait-free and as cheap as plain memory, while any
+     * other thread may read a live histogram (merge it into its own, copy it) at any time.
+     * Such a reader sees every record made before the last one or two, which is all that
+     * monitoring needs.
+     */
+    class Histogram {
+    public:
+        static constexpr unsigned kSubBucketBits   = 5;
+        static constexpr uint64_t kSubBuckets      = uint64_t {1} << kSubBucketBits;
+        static constexpr std::size_t kBucketCount  = (64 - kSubBucketBits + 1) * kSubBuckets;
+
+        Histogram() = default;
+
+        Histogram(const Histogram& other) {
+            merge(other);
+        }
+
+        Histogram& operator=(const Histogram& other) {
+            if (this != &other) {
+                reset();
+                merge(other);
+            }
+            return *this;
+        }
+
+        void record(const uint64_t value) {
+            add(m_counts[indexOf(value)], 1);
+            add(m_count, 1);
+            add(m_sum, value);
+            if (value < load(m_min)) m_min.store(value, std::memory_order_relaxed);
+            if (value > load(m_max)) m_max.store(value, std::memory_order_relaxed);
+        }
+
+        void merge(const Histogram& other);
+        void reset();
+
+        uint64_t count() const {
+            return load(m_count);
+        }
+
+        uint64_t sum() const {
+            return load(m_sum);
+        }
+
+        uint64_t min() const {
+            return count() == 0 ? 0 : load(m_min);
+        }
+
+        uint64_t max() const {
+            return load(m_max);
+        }
+
+        double mean() const {
+            const uint64_t recorded = count();
+            return recorded == 0 ? 0.0 : static_cast<double>(sum()) / static_cast<double>(recorded);
+        }
+
+        /**
+         * @brief Smallest recorded value such that quantile of the values are at or below it,
+         * rounded up to the end of its bucket (and never above max())
+         * @param[in] quantile    Between 0 and 1, e.g. 0.999 for p99.9
+         */
+        uint64_t percentile(double quantile) const;
+
+        /**
+         * @brief Number of values recorded in buckets that end at or below value, for exporting
+         * cumulative buckets with fixed boundaries (values sharing a bucket with the boundary are
+         * left out)
+         */
+        uint64_t countAtOrBelow(uint64_t value) const;
+
+        /**
+         * @brief Number of values in the buckets. Unlike count(), it always agrees with
+         * percentile() and countAtOrBelow(), even while a writer is ahead of the reader
+         */
+        uint64_t bucketTotal() const;
+
+        //! Index of the bucket holding value
+        static std::size_t indexOf(const uint64_t value) {
+            if (value < kSubBuckets) return static_cast<std::size_t>(value);
+            const unsigned exponent = 63u - static_cast<unsigned>(__builtin_clzll(value));
+            const unsigned shift    = exponent - kSubBucketBits;
+            return static_cast<std::size_t>((shift + 1) * kSubBuckets + ((value >> shift) - kSubBuckets));
+        }
+
+        //! Largest value that falls in a bucket
+        static uint64_t upperBound(std::size_t index);
+
+    private:
+        using Cell = std::atomic<uint64_t>;
+
+        std::array<Cell, kBucketCount> m_counts {};
+        Cell m_count {0};
+        Cell m_sum {0};
+        Cell m_min {UINT64_MAX};
+        Cell m_max {0};
+
+        static uint64_t load(const Cell& cell) {
+            return cell.load(std::memory_order_relaxed);
+        }
+
+        // Only the owner writes, so a load and a store replace the locked read-modify-write
+        static void add(Cell& cell, const uint64_t amount) {
+            cell.store(load(cell) + amount, std::memory_order_relaxed);
+        }
+    };
+} // namespace metrics
+
+#endif // define METRICS_HISTOGRAM_H
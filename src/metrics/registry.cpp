@@ -0,0 +1,96 @@
+#include "metrics/registry.h"
+
+#include <string_view>
+
+#include "utils/utils.h"
+
+namespace metrics {
+    namespace {
+        constexpr std::string_view kPrefix = "sagan_";
+
+        struct Bound {
+            uint64_t nanoseconds;
+            std::string_view seconds; //!< Value of the le label
+        };
+
+        // Exported histogram buckets, from a microsecond to ten seconds
+        constexpr Bound kBounds[] {
+            {1000, "0.000001"},     {2500, "0.0000025"},     {5000, "0.000005"},     {10000, "0.00001"},
+            {25000, "0.000025"},    {50000, "0.00005"},      {100000, "0.0001"},     {250000, "0.00025"},
+            {500000, "0.0005"},     {1000000, "0.001"},      {2500000, "0.0025"},    {5000000, "0.005"},
+            {10000000, "0.01"},     {25000000, "0.025"},     {50000000, "0.05"},     {100000000, "0.1"},
+            {250000000, "0.25"},    {500000000, "0.5"},      {1000000000, "1"},      {2500000000, "2.5"},
+            {5000000000, "5"},      {10000000000, "10"},
+        };
+
+        constexpr std::string_view kQuantiles[] {"0.5", "0.99", "0.999"};
+        constexpr double kQuantileValues[] {0.5, 0.99, 0.999};
+
+        double seconds(const uint64_t nanoseconds) {
+            return static_cast<double>(nanoseconds) / 1e9;
+        }
+
+        void describe(memory::Buffer& out, const std::string_view name, const std::string_view help, const std::string_view type) {
+            Utils::append(out, "# HELP ", kPrefix, name, ' ', help, "\n# TYPE ", kPrefix, name, ' ', type, '\n');
+        }
+    } // namespace
+
+    ReactorMetrics& Registry::add() {
+        m_reactors.push_back(std::make_unique<ReactorMetrics>());
+        return *m_reactors.back();
+    }
+
+    std::unique_ptr<Snapshot> Registry::collect() const {
+        auto snapshot = std::make_unique<Snapshot>();
+        for (const auto& reactor : m_reactors) {
+            for (std::size_t i = 0; i < kCounterCount; ++i) snapshot->counters[i] += reactor->value(static_cast<Counter>(i));
+            for (std::size_t i = 0; i < kPhaseCount; ++i) snapshot->phases[i].merge(reactor->phase(static_cast<Phase>(i)));
+        }
+        return snapshot;
+    }
+
+    void Registry::render(memory::Buffer& out) const {
+        const std::unique_ptr<Snapshot> snapshot = collect();
+
+        for (std::size_t i = 0; i < kCounterCount; ++i) {
+            const detail::CounterInfo& counter = detail::kCounters[i];
+            Utils::append(out, "# HELP ", kPrefix, counter.name, "_total ", counter.help, "\n# TYPE ", kPrefix, counter.name,
+                          "_total counter\n", kPrefix, counter.name, "_total ", snapshot->counters[i], '\n');
+        }
+
+        // The closing thread may have counted before the accepting one, never report a negative gauge
+        const uint64_t accepted = snapshot->value(Counter::connections_accepted);
+        const uint64_t closed   = snapshot->value(Counter::connections_closed);
+        describe(out, "connections_open", "Connections currently open", "gauge");
+        Utils::append(out, kPrefix, "connections_open ", accepted > closed ? accepted - closed : 0, '\n');
+        describe(out, "reactors", "Reactor threads", "gauge");
+        Utils::append(out, kPrefix, "reactors ", m_reactors.size(), '\n');
+
+        describe(out, "phase_duration_seconds", "Time spent in each phase of serving a connection", "histogram");
+        for (std::size_t i = 0; i < kPhaseCount; ++i) {
+            const std::string_view phase = phaseName(static_cast<Phase>(i));
+            const Histogram& histogram   = snapshot->phases[i];
+            // +Inf and _count come from the same buckets as the others, so they never fall below them
+            const uint64_t total = histogram.bucketTotal();
+            for (const Bound& bound : kBounds) {
+                Utils::append(out, kPrefix, "phase_duration_seconds_bucket{phase=\"", phase, "\",le=\"", bound.seconds, "\"} ",
+                              histogram.countAtOrBelow(bound.nanoseconds), '\n');
+            }
+            Utils::append(out, kPrefix, "phase_duration_seconds_bucket{phase=\"", phase, "\",le=\"+Inf\"} ", total, '\n');
+            Utils::append(out, kPrefix, "phase_duration_seconds_sum{phase=\"", phase, "\"} ", seconds(histogram.sum()), '\n');
+            Utils::append(out, kPrefix, "phase_duration_seconds_count{phase=\"", phase, "\"} ", total, '\n');
+        }
+
+        describe(out, "phase_latency_seconds", "Percentiles of each phase since the server started", "summary");
+        for (std::size_t i = 0; i < kPhaseCount; ++i) {
+            const std::string_view phase = phaseName(static_cast<Phase>(i));
+            const Histogram& histogram   = snapshot->phases[i];
+            for (std::size_t q = 0; q < sizeof(kQuantileValues) / sizeof(kQuantileValues[0]); ++q) {
+                Utils::append(out, kPrefix, "phase_latency_seconds{phase=\"", phase, "\",quantile=\"", kQuantiles[q], "\"} ",
+                              seconds(histogram.percentile(kQuantileValues[q])), '\n');
+            }
+            Utils::append(out, kPrefix, "phase_latency_seconds_sum{phase=\"", phase, "\"} ", seconds(histogram.sum()), '\n');
+            Utils::append(out, kPrefix, "phase_latency_seconds_count{phase=\"", phase, "\"} ", histogram.bucketTotal(), '\n');
+        }
+    }
+} // namespace metrics
@@ -0,0 +1,133 @@
+#ifndef METRICS_REGISTRY_H
+#define METRICS_REGISTRY_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include "memory/buffer.h"
+#include "metrics/histogram.h"
+
+namespace metrics {
+    /**
+     * Every counter kept by a reactor, as (name, help) pairs. The enum and the exported
+     * names are generated from this list, each becomes sagan_<name>_total.
+     */
+#define SAGAN_METRICS_COUNTERS(X) \
+    X(connections_accepted, "Connections accepted") \
+    X(connections_closed, "Connections closed") \
+    X(requests, "Requests parsed and answered") \
+    X(request_errors, "Requests rejected before reaching the handler") \
+    X(cache_hits, "Responses served from the response cache") \
+    X(bytes_received, "Bytes read from client connections") \
+    X(bytes_sent, "Bytes written to client connections")
+
+    enum class Counter : uint8_t {
+#define SAGAN_METRICS_COUNTER_ID(name, help) name,
+        SAGAN_METRICS_COUNTERS(SAGAN_METRICS_COUNTER_ID)
+#undef SAGAN_METRICS_COUNTER_ID
+    };
+
+    namespace detail {
+        struct CounterInfo {
+            std::string_view name;
+            std::string_view help;
+        };
+
+        constexpr CounterInfo kCounters[] {
+#define SAGAN_METRICS_COUNTER_INFO(name, help) {#name, help},
+            SAGAN_METRICS_COUNTERS(SAGAN_METRICS_COUNTER_INFO)
+#undef SAGAN_METRICS_COUNTER_INFO
+        };
+    } // namespace detail
+
+    constexpr std::size_t kCounterCount = sizeof(detail::kCounters) / sizeof(detail::kCounters[0]);
+
+    //! Timed steps of serving a connection, each with its own latency histogram
+    enum class Phase : uint8_t {
+        accept, //!< accept4() and registering the connection
+        parse,  //!< The parse() call that completed a request head
+        handle, //!< Cache lookup, handler and compression
+        write,  //!< Sending output and file bodies to the socket
+    };
+
+    constexpr std::size_t kPhaseCount = 4;
+
+    constexpr std::string_view phaseName(const Phase phase) {
+        constexpr std::string_view kNames[kPhaseCount] {"accept", "parse", "handle", "write"};
+        return kNames[static_cast<std::size_t>(phase)];
+    }
+
+    /**
+     * Counters and phase histograms of one reactor. Only the reactor thread records, with
+     * relaxed loads and stores instead of locked increments (see Histogram), so recording is
+     * wait-free and no cache line is shared with another reactor. Any thread may read.
+     */
+    class alignas(64) ReactorMetrics {
+    public:
+        void add(const Counter counter, const uint64_t amount = 1) {
+            std::atomic<uint64_t>& cell = m_counters[static_cast<std::size_t>(counter)];
+            cell.store(cell.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+        }
+
+        void record(const Phase phase, const uint64_t nanoseconds) {
+            m_phases[static_cast<std::size_t>(phase)].record(nanoseconds);
+        }
+
+        uint64_t value(const Counter counter) const {
+            return m_counters[static_cast<std::size_t>(counter)].load(std::memory_order_relaxed);
+        }
+
+        const Histogram& phase(const Phase phase) const {
+            return m_phases[static_cast<std::size_t>(phase)];
+        }
+
+    private:
+        std::array<std::atomic<uint64_t>, kCounterCount> m_counters {};
+        std::array<Histogram, kPhaseCount> m_phases;
+    };
+
+    //! Sum of the metrics of every reactor at one point in time
+    struct Snapshot {
+        std::array<uint64_t, kCounterCount> counters {};
+        std::array<Histogram, kPhaseCount> phases;
+
+        uint64_t value(const Counter counter) const {
+            return counters[static_cast<std::size_t>(counter)];
+        }
+    };
+
+    /**
+     * Metrics of every reactor of a server. Reactors register while the server is constructed,
+     * before any thread starts, and the list never changes afterwards: collect() walks it from
+     * any thread without locks, merging on demand instead of on every request.
+     */
+    class Registry {
+    public:
+        /**
+         * @brief Metrics for a new reactor, only call before the reactors start
+         * @return Storage owned by the registry, recorded into by that reactor only
+         */
+        ReactorMetrics& add();
+
+        /**
+         * @brief Merges the metrics of every reactor
+         */
+        std::unique_ptr<Snapshot> collect() const;
+
+        /**
+         * @brief Appends every metric in the Prometheus text exposition format (version 0.0.4),
+         * durations in seconds. Phases are exported as histograms and as p50/p99/p99.9 summaries
+         */
+        void render(memory::Buffer& out) const;
+
+    private:
+        std::vector<std::unique_ptr<ReactorMetrics>> m_reactors;
+    };
+} // namespace metrics
+
+#endif // define METRICS_REGISTRY_H
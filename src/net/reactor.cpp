@@ -0,0 +1,506 @@
+#include "net/reactor.h"
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/sendfile.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cmath>
+#include <system_error>
+#include <utility>
+
+#include "http/field_value.h"
+#include "net/socket.h"
+#include "utils/utils.h"
+
+namespace net {
+    namespace {
+        constexpr int kMaxEvents         = 256;
+        constexpr int kTickMilliseconds  = 1000; // Upper bound between two idle sweeps
+        constexpr std::size_t kReadChunk = 16 * 1024;
+        constexpr uint64_t kMaxSendfile  = 1 << 30; // Largest single sendfile() request
+
+        //! Parses a content-length value, rejecting signs, whitespace and overflow
+        bool parseLength(const std::string_view value, std::size_t& length) {
+            if (value.empty()) return false;
+            const auto result = std::from_chars(value.data(), value.data() + value.size(), length);
+            return result.ec == std::errc() && result.ptr == value.data() + value.size();
+        }
+
+        /**
+         * Body length of a request from every content-length field: repeated or listed values
+         * must all agree (RFC 7230, 3.3.2), a disagreement could frame the body differently
+         * than a proxy in front of us did
+         * @return False if a value is invalid or the values differ
+         */
+        bool requestLength(const http::Request& request, std::size_t& length) {
+            bool found = false;
+            bool valid = true;
+            length     = 0;
+            for (std::size_t i = 0; i < request.field_count && valid; ++i) {
+                if (request.fields[i].id != http::headers::Id::content_length) continue;
+                bool listed = false;
+                http::forEachListItem(request.fields[i].value, [&](const std::string_view item) {
+                    std::size_t value = 0;
+                    valid  = parseLength(item, value) && (!found || value == length);
+                    found  = true;
+                    listed = true;
+                    length = value;
+                    return valid;
+                });
+                if (!listed) return false; // Empty, or only commas
+            }
+            return valid;
+        }
+
+        //! Whether a request carries a field at all, even with an empty value
+        bool hasField(const http::Request& request, const http::headers::Id id) {
+            for (std::size_t i = 0; i < request.field_count; ++i) {
+                if (request.fields[i].id == id) return true;
+            }
+            return false;
+        }
+
+        //! Milliseconds rounded to the microsecond, the unit and precision of server-timing
+        double milliseconds(const std::chrono::steady_clock::duration elapsed) {
+            return std::round(std::chrono::duration<double, std::micro>(elapsed).count()) / 1000.0;
+        }
+    } // namespace
+
+    Reactor::Reactor(const int listener, const Config& config, http::Handler handler,
+                     std::shared_ptr<http::ResponseCache> cache, std::shared_ptr<metrics::Registry> registry) :
+        m_listener(listener), m_config(config), m_handler(std::move(handler)), m_cache(std::move(cache)),
+        m_registry(std::move(registry)) {
+        m_epoll  = epoll_create1(EPOLL_CLOEXEC);
+        m_wakeup = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (m_epoll < 0 || m_wakeup < 0) {
+            const int error = errno;
+            if (m_epoll >= 0) close(m_epoll);
+            if (m_wakeup >= 0) close(m_wakeup);
+            close(m_listener);
+            throw std::system_error(error, std::generic_category(), "epoll");
+        }
+        if (m_registry) m_metrics = &m_registry->add();
+        m_timed = m_metrics || m_config.server_timing;
+
+        // The listener and the wakeup descriptor are told apart from connections by address
+        epoll_event event {};
+        event.events   = EPOLLIN | EPOLLET;
+        event.data.ptr = &m_listener;
+        epoll_ctl(m_epoll, EPOLL_CTL_ADD, m_listener, &event);
+        event.events   = EPOLLIN;
+        event.data.ptr = &m_wakeup;
+        epoll_ctl(m_epoll, EPOLL_CTL_ADD, m_wakeup, &event);
+    }
+
+    Reactor::~Reactor() {
+        for (auto& entry : m_connections) close(entry.first);
+        close(m_wakeup);
+        close(m_epoll);
+        if (m_listener >= 0) close(m_listener);
+    }
+
+    void Reactor::run() {
+        epoll_event events[kMaxEvents];
+        m_now = std::time(nullptr);
+        m_date.update(m_now);
+
+        try {
+            while (!m_stopping.load(std::memory_order_relaxed)) {
+                const int count = epoll_wait(m_epoll, events, kMaxEvents, kTickMilliseconds);
+                if (count < 0 && errno != EINTR) throw std::system_error(errno, std::generic_category(), "epoll_wait");
+
+                m_now = std::time(nullptr);
+                m_date.update(m_now);
+
+                bool accepted = false;
+                for (int i = 0; i < count; ++i) {
+                    void* tag = events[i].data.ptr;
+                    if (tag == &m_listener) {
+                        acceptConnections();
+                        accepted = true;
+                    } else if (tag != &m_wakeup) {
+                        onEvent(*static_cast<Connection*>(tag), events[i].events);
+                    }
+                }
+
+                // The edge that reported them is gone, retry once descriptors may have been freed
+                if (m_accept_blocked && !accepted) acceptConnections();
+                if (!m_revalidations.empty()) revalidate();
+                if (m_now != m_last_sweep) closeIdle();
+            }
+        } catch (...) {
+            // Leave the SO_REUSEPORT group, or the kernel keeps queueing connections nobody accepts
+            close(m_listener);
+            m_listener = -1;
+            while (!m_connections.empty()) closeConnection(*m_connections.begin()->second);
+            throw;
+        }
+
+        // Connections are torn down here so that their memory goes back to this thread's pool
+        while (!m_connections.empty()) closeConnection(*m_connections.begin()->second);
+    }
+
+    void Reactor::stop() {
+        m_stopping.store(true, std::memory_order_relaxed);
+        const uint64_t one = 1;
+        if (write(m_wakeup, &one, sizeof(one)) < 0) return; // Already signalled
+    }
+
+    void Reactor::acceptConnections() {
+        for (;;) {
+            const Clock::time_point start = now();
+            sockaddr_in peer {};
+            socklen_t peer_length = sizeof(peer);
+            const int fd          = accept4(m_listener, reinterpret_cast<sockaddr*>(&peer), &peer_length, SOCK_NONBLOCK | SOCK_CLOEXEC);
+            if (fd < 0) {
+                if (errno == EINTR || errno == ECONNABORTED) continue;
+                // Out of descriptors or memory: the queued connections stay in the backlog and are
+                // accepted by run() once a connection closes or at the next tick
+                m_accept_blocked = errno == EMFILE || errno == ENFILE || errno == ENOBUFS || errno == ENOMEM;
+                return;
+            }
+            setNoDelay(fd);
+
+            auto connection         = std::make_unique<Connection>(fd);
+            connection->last_active = m_now;
+            connection->local       = isLoopback(peer);
+
+            epoll_event event {};
+            event.events   = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+            event.data.ptr = connection.get();
+            if (epoll_ctl(m_epoll, EPOLL_CTL_ADD, fd, &event) < 0) {
+                close(fd);
+                continue;
+            }
+            m_connections.emplace(fd, std::move(connection));
+            count(metrics::Counter::connections_accepted);
+            record(metrics::Phase::accept, start, now());
+        }
+    }
+
+    void Reactor::onEvent(Connection& connection, const uint32_t events) {
+        if (events & EPOLLERR) return closeConnection(connection);
+        connection.last_active = m_now;
+
+        if (events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP)) {
+            if (!readRequests(connection)) return closeConnection(connection);
+        }
+
+        for (;;) {
+            const bool pending            = !connection.output.empty() || connection.file.fd >= 0;
+            const Clock::time_point start = pending ? now() : Clock::time_point {};
+            if (!flush(connection)) return closeConnection(connection);
+            if (pending) record(metrics::Phase::write, start, now());
+
+            const bool idle = connection.output.empty() && connection.file.fd < 0;
+            if (connection.closing && idle) return closeConnection(connection);
+
+            // A file body was sent in full: answer the pipelined requests it was holding back, and
+            // read what was left in the socket when the input filled up (no new edge will report it)
+            if (!idle || connection.closing) return;
+            if (connection.backlogged) {
+                if (!readRequests(connection)) return closeConnection(connection);
+            } else {
+                if (connection.input.empty()) return;
+                process(connection);
+            }
+            if (connection.output.empty()) return;
+        }
+    }
+
+    bool Reactor::readRequests(Connection& connection) {
+        ReadStatus status;
+        do {
+            status = receive(connection);
+            if (status == ReadStatus::error) return false;
+            process(connection);
+
+            // A full input behind a file body cannot shrink until the file is sent, stop reading
+            connection.backlogged = status == ReadStatus::full && connection.file.fd >= 0;
+        } while (status == ReadStatus::full && !connection.closing && !connection.backlogged);
+
+        // Answer what was already received, then close: the peer will not send more
+        if (status == ReadStatus::eof) connection.closing = true;
+        return true;
+    }
+
+    Reactor::ReadStatus Reactor::receive(Connection& connection) {
+        // Bounded so that a client pipelining faster than we answer cannot grow the buffer forever
+        const std::size_t limit = http::kMaxHeadSize + m_config.max_body_size + kReadChunk;
+        memory::Buffer& input   = connection.input;
+
+        for (;;) {
+            if (input.size() >= limit) return ReadStatus::full;
+
+            input.reserve(std::min(kReadChunk, limit - input.size()));
+            const ssize_t received = recv(connection.fd, input.tail(), input.tailSize(), 0);
+            if (received > 0) {
+                input.commit(static_cast<std::size_t>(received));
+                count(metrics::Counter::bytes_received, static_cast<uint64_t>(received));
+                continue;
+            }
+
+            // An empty buffer goes back to the pool instead of waiting for the next request
+            if (input.empty()) input.clear();
+            if (received == 0) return ReadStatus::eof;
+            if (errno == EINTR) continue;
+            return (errno == EAGAIN || errno == EWOULDBLOCK) ? ReadStatus::drained : ReadStatus::error;
+        }
+    }
+
+    void Reactor::process(Connection& connection) {
+        while (!connection.closing && !connection.input.empty() && connection.file.fd < 0) {
+            const std::string_view pending = connection.input.view();
+
+            const Clock::time_point start  = now();
+            const http::ParseResult result = connection.parser.parse(pending, connection.request);
+            const Clock::time_point parsed = now();
+            if (result == http::ParseResult::incomplete) break;
+            if (result == http::ParseResult::invalid) return respondError(connection, 400);
+            if (result == http::ParseResult::too_large) return respondError(connection, 431);
+
+            const http::Request& request = connection.request;
+            if (!request.header(http::headers::Id::transfer_encoding).empty()) return respondError(connection, 501);
+
+            // HTTP/1.1 requires a host field (RFC 7230, 5.4), the response cache keys on it
+            if (request.version_minor == 1 && !hasField(request, http::headers::Id::host)) return respondError(connection, 400);
+
+            std::size_t body_length = 0;
+            if (!requestLength(request, body_length)) return respondError(connection, 400);
+            if (body_length > m_config.max_body_size) return respondError(connection, 413);
+
+            const std::size_t head = connection.parser.consumed();
+            if (pending.size() - head < body_length) break; // The parser keeps its state until the body arrives
+            connection.request.body = pending.substr(head, body_length);
+
+            ++connection.served;
+            count(metrics::Counter::requests);
+            const bool keep_alive = request.keepAlive() && connection.served < m_config.keep_alive_requests &&
+                                    !m_stopping.load(std::memory_order_relaxed);
+
+            http::Framing framing;
+            framing.date               = m_date.value();
+            framing.keep_alive         = keep_alive;
+            framing.head               = request.method == http::Method::head;
+            framing.version_minor      = request.version_minor;
+            framing.keep_alive_timeout = m_config.keep_alive_timeout;
+
+            // Recorded once the response is ready, the durations also go out in server-timing
+            char timing[96];
+            const auto handled = [&](const std::string_view step) {
+                const Clock::time_point done = now();
+                record(metrics::Phase::parse, start, parsed);
+                record(metrics::Phase::handle, parsed, done);
+                if (m_config.server_timing) {
+                    framing.server_timing = Utils::format(timing, "parse;dur=", milliseconds(parsed - start), ", ", step,
+                                                          ";dur=", milliseconds(done - parsed));
+                }
+            };
+
+            const bool internal            = servesMetrics(connection);
+            const http::CacheLookup cached = m_cache && !internal ? m_cache->find(request, m_now) : http::CacheLookup {};
+            bool failed                    = false;
+            if (cached.response) {
+                count(metrics::Counter::cache_hits);
+                handled("cache");
+                if (connection.output.empty() && connection.file.fd < 0) {
+                    sendCached(connection, *cached.response, framing);
+                } else {
+                    http::serializeCached(*cached.response, framing, m_now, connection.output);
+                }
+                if (cached.revalidate) m_revalidations.emplace_back(pending.substr(0, head));
+            } else {
+                http::Response response(connection.arena);
+                std::unique_ptr<http::Deflater> deflater;
+                failed = !produce(request, response, deflater, internal);
+                if (!failed) {
+                    handled("handle");
+                    http::serialize(response, framing, connection.output);
+                    if (m_cache) m_cache->store(request, response, framing.date, m_now);
+                    if (response.file.fd >= 0 && !framing.head && http::allowsBody(response.status)) {
+                        connection.file     = std::move(response.file);
+                        connection.deflater = std::move(deflater);
+                    }
+                }
+            }
+            // The responses already queued for earlier pipelined requests still go out before the 500
+            if (failed) return respondError(connection, 500);
+            connection.arena.reset();
+
+            // Consuming only moves an offset, pipelined requests are never copied
+            connection.input.consume(head + body_length);
+            connection.parser.reset();
+            if (!keep_alive) connection.closing = true;
+        }
+    }
+
+    void Reactor::sendCached(Connection& connection, const http::CachedResponse& cached, const http::Framing& framing) {
+        // Only the age and the connection headers are formatted, the head and body go out from the entry
+        memory::Buffer per_request;
+        http::serializeCachedFraming(cached, framing, m_now, per_request);
+
+        Utils::Gather<4> parts;
+        parts.add(http::statusPrefix(framing.version_minor));
+        parts.add(cached.head);
+        parts.add(per_request.view());
+        if (!framing.head && http::allowsBody(cached.status)) parts.add(cached.body);
+
+        // What the socket did not take is copied and left to flush(), which also reports errors
+        const Clock::time_point start = now();
+        const ssize_t sent            = parts.send(connection.fd, MSG_NOSIGNAL);
+        record(metrics::Phase::write, start, now());
+        if (sent > 0) count(metrics::Counter::bytes_sent, static_cast<uint64_t>(sent));
+        parts.forEachAfter(sent > 0 ? static_cast<std::size_t>(sent) : 0, [&](const std::string_view rest) {
+            connection.output.append(rest);
+        });
+    }
+
+    void Reactor::revalidate() {
+        // Runs after the event batch, so the stale responses were already flushed to their clients
+        memory::Arena arena;
+        for (const std::string& raw : m_revalidations) {
+            http::RequestParser parser;
+            http::Request request;
+            if (parser.parse(raw, request) != http::ParseResult::complete) continue;
+
+            {
+                http::Response response(arena);
+                std::unique_ptr<http::Deflater> deflater;
+                if (produce(request, response, deflater, false)) m_cache->store(request, response, m_date.value(), m_now);
+            }
+            arena.reset();
+        }
+        m_revalidations.clear();
+    }
+
+    bool Reactor::produce(const http::Request& request, http::Response& response, std::unique_ptr<http::Deflater>& deflater,
+                          const bool internal) {
+        // A throwing handler costs its own request a 500, never the reactor and its other connections
+        try {
+            if (internal) {
+                writeMetrics(response);
+            } else {
+                m_handler(request, response);
+            }
+            deflater = http::compressResponse(request, response, m_config.compression_level);
+            return true;
+        } catch (...) {
+            return false;
+        }
+    }
+
+    void Reactor::respondError(Connection& connection, const uint16_t status) {
+        count(metrics::Counter::request_errors);
+        {
+            http::Response response(connection.arena);
+            response.status = status;
+            response.body.assign(http::reasonPhrase(status));
+
+            http::Framing framing;
+            framing.date       = m_date.value();
+            framing.keep_alive = false;
+            http::serialize(response, framing, connection.output);
+        }
+        connection.arena.reset();
+        connection.closing = true;
+    }
+
+    bool Reactor::servesMetrics(const Connection& connection) const {
+        // Only reachable from the host itself, the metrics are not meant for the public
+        const http::Request& request = connection.request;
+        if (!m_registry || !connection.local) return false;
+        if (request.method != http::Method::get && request.method != http::Method::head) return false;
+        return request.target.substr(0, request.target.find('?')) == m_config.metrics_path;
+    }
+
+    void Reactor::writeMetrics(http::Response& response) const {
+        memory::Buffer text;
+        m_registry->render(text);
+        response.set(http::headers::body_information::content_type, "text/plain; version=0.0.4; charset=utf-8");
+        response.set(http::headers::caching::cache_control, "no-store");
+        response.body.assign(text.view());
+    }
+
+    bool Reactor::flush(Connection& connection) {
+        memory::Buffer& output = connection.output;
+        for (;;) {
+            const int more = connection.file.fd >= 0 ? MSG_MORE : 0; // Head and file in full frames
+            while (!output.empty()) {
+                const ssize_t sent = send(connection.fd, output.data(), output.size(), MSG_NOSIGNAL | more);
+                if (sent < 0) {
+                    if (errno == EINTR) continue;
+                    return errno == EAGAIN || errno == EWOULDBLOCK; // Resumed on the next EPOLLOUT edge
+                }
+                output.consume(static_cast<std::size_t>(sent));
+                count(metrics::Counter::bytes_sent, static_cast<uint64_t>(sent));
+            }
+
+            // A compressed file is produced one read at a time, only once the previous output is gone
+            if (!connection.deflater) break;
+            if (!compressFile(connection)) return false;
+        }
+
+        http::FileRange& file = connection.file;
+        while (file.length > 0) {
+            off_t offset       = static_cast<off_t>(file.offset);
+            const ssize_t sent = sendfile(connection.fd, file.fd, &offset, std::min<uint64_t>(file.length, kMaxSendfile));
+            if (sent < 0) {
+                if (errno == EINTR) continue;
+                return errno == EAGAIN || errno == EWOULDBLOCK;
+            }
+            if (sent == 0) return false; // The file shrank under us, the framing cannot be honoured
+            count(metrics::Counter::bytes_sent, static_cast<uint64_t>(sent));
+            file.offset += static_cast<uint64_t>(sent);
+            file.length -= static_cast<uint64_t>(sent);
+        }
+        if (file.fd >= 0) file = http::FileRange {};
+        return true;
+    }
+
+    bool Reactor::compressFile(Connection& connection) {
+        http::FileRange& file = connection.file;
+        char chunk[kReadChunk];
+        ssize_t received;
+        do {
+            received = pread(file.fd, chunk, std::min<uint64_t>(file.length, sizeof(chunk)), static_cast<off_t>(file.offset));
+        } while (received < 0 && errno == EINTR);
+        if (received < 0 || (received == 0 && file.length > 0)) return false; // Unreadable or shrunk
+
+        file.offset += static_cast<uint64_t>(received);
+        file.length -= static_cast<uint64_t>(received);
+
+        std::string_view input(chunk, static_cast<std::size_t>(received));
+        const bool finish = file.length == 0;
+        bool ended        = false;
+        while (!input.empty() || (finish && !ended)) ended = connection.deflater->write(input, finish, connection.output);
+
+        if (ended) {
+            connection.deflater.reset();
+            file = http::FileRange {};
+        }
+        return true;
+    }
+
+    void Reactor::closeConnection(Connection& connection) {
+        const int fd = connection.fd;
+        count(metrics::Counter::connections_closed);
+        epoll_ctl(m_epoll, EPOLL_CTL_DEL, fd, nullptr);
+        close(fd);
+        m_connections.erase(fd); // Destroys connection
+    }
+
+    void Reactor::closeIdle() {
+        m_last_sweep = m_now;
+        const std::time_t deadline = m_now - static_cast<std::time_t>(m_config.keep_alive_timeout);
+        for (auto it = m_connections.begin(); it != m_connections.end();) {
+            Connection& connection = *it->second;
+            ++it;
+            if (connection.last_active < deadline) closeConnection(connection);
+        }
+    }
+} // namespace net
@@ -0,0 +1,147 @@
+#ifndef NET_REACTOR_H
+#define NET_REACTOR_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "http/compression.h"
+#include "http/date.h"
+#include "http/request_parser.h"
+#include "http/response.h"
+#include "http/response_cache.h"
+#include "memory/arena.h"
+#include "memory/buffer.h"
+#include "metrics/registry.h"
+
+namespace net {
+    struct Config {
+        uint16_t port {8080};
+        std::size_t threads {0};                 //!< Reactor threads, 0 uses every hardware thread
+        bool pin_threads {false};                //!< Pin reactor i to CPU i
+        int backlog {4096};                      //!< Pending connections queue of each listener
+        uint32_t keep_alive_timeout {5};         //!< Seconds an idle persistent connection is kept
+        uint32_t keep_alive_requests {1000};     //!< Requests served before a connection is closed
+        std::size_t max_body_size {1024 * 1024}; //!< Larger request bodies are answered with 413
+        std::size_t cache_size {0};              //!< Bytes of the shared response cache, 0 disables it
+        int compression_level {0};               //!< zlib level for gzip/deflate responses, 0 disables compression
+        std::string metrics_path;                //!< Target answered with the metrics to loopback clients, empty disables metrics
+        bool server_timing {false};              //!< Add a server-timing header with the parse and handle durations
+    };
+
+    /**
+     * State of one client connection, owned by the reactor that accepted it. The buffers and
+     * the arena only hold pooled memory while a request is in flight.
+     */
+    struct Connection {
+        explicit Connection(const int socket) :
+            fd(socket) {}
+
+        int fd;
+        memory::Buffer input;  //!< Received bytes, starting with the current request
+        memory::Buffer output; //!< Serialised responses not yet sent
+        memory::Arena arena;   //!< Response data, reset once the response is serialised
+        http::FileRange file;  //!< File body sent after output, holds back pipelined responses
+        std::unique_ptr<http::Deflater> deflater; //!< Compresses file as it is sent instead of sendfile()
+        http::RequestParser parser;
+        http::Request request;
+        uint32_t served {0};   //!< Requests answered on this connection
+        std::time_t last_active {0};
+        bool closing {false};  //!< Close once the output has been flushed
+        bool local {false};    //!< Peer on the loopback network, allowed to read the metrics
+        bool backlogged {false}; //!< Input filled up behind a file body, reading resumes once it is sent
+    };
+
+    /**
+     * Edge-triggered epoll event loop. Each reactor owns a SO_REUSEPORT listener, so the kernel
+     * spreads new connections over the reactors and a connection never leaves the thread that
+     * accepted it: no locks are taken while serving requests.
+     */
+    class Reactor {
+    public:
+        /**
+         * @param[in] listener    Listening socket, owned by the reactor from now on
+         * @param[in] config      Server configuration
+         * @param[in] handler     Called for every complete request
+         * @param[in] cache       Response cache shared by the reactors, may be nullptr
+         * @param[in] registry    Metrics shared by the reactors, may be nullptr. The reactor
+         *                        registers its own counters, so it must be built before any reactor runs
+         * @throws std::system_error if the epoll instance cannot be created
+         */
+        Reactor(int listener, const Config& config, http::Handler handler, std::shared_ptr<http::ResponseCache> cache = nullptr,
+                std::shared_ptr<metrics::Registry> registry = nullptr);
+        ~Reactor();
+
+        Reactor(const Reactor&) = delete;
+        Reactor& operator=(const Reactor&) = delete;
+
+        /**
+         * @brief Serves connections until stop() is called
+         * @throws Whatever escaped serving a connection (std::bad_alloc, std::system_error), after
+         * closing the listener and every connection of this reactor
+         */
+        void run();
+
+        /**
+         * @brief Asks the event loop to return, safe to call from any thread
+         */
+        void stop();
+
+    private:
+        enum class ReadStatus { drained, full, eof, error };
+        using Clock = std::chrono::steady_clock;
+
+        int m_listener;
+        int m_epoll {-1};
+        int m_wakeup {-1};
+        Config m_config;
+        http::Handler m_handler;
+        std::shared_ptr<http::ResponseCache> m_cache;
+        std::vector<std::string> m_revalidations; // Heads of requests whose stale response was served
+        std::shared_ptr<metrics::Registry> m_registry;
+        metrics::ReactorMetrics* m_metrics {nullptr}; // Written by this thread only, nullptr when disabled
+        bool m_timed {false};                         // Phases are timed, for the metrics or server-timing
+        std::atomic<bool> m_stopping {false};
+        bool m_accept_blocked {false}; // accept4() ran out of descriptors, the listener has no new edge
+        std::unordered_map<int, std::unique_ptr<Connection>> m_connections;
+        http::DateCache m_date;
+        std::time_t m_now {0};
+        std::time_t m_last_sweep {0};
+
+        void acceptConnections();
+        void onEvent(Connection& connection, uint32_t events);
+        bool readRequests(Connection& connection);
+        ReadStatus receive(Connection& connection);
+        void process(Connection& connection);
+        void sendCached(Connection& connection, const http::CachedResponse& cached, const http::Framing& framing);
+        void revalidate();
+        bool produce(const http::Request& request, http::Response& response, std::unique_ptr<http::Deflater>& deflater, bool internal);
+        void respondError(Connection& connection, uint16_t status);
+        bool servesMetrics(const Connection& connection) const;
+        void writeMetrics(http::Response& response) const;
+        bool flush(Connection& connection);
+        bool compressFile(Connection& connection);
+        void closeConnection(Connection& connection);
+        void closeIdle();
+
+        Clock::time_point now() const {
+            return m_timed ? Clock::now() : Clock::time_point {};
+        }
+
+        void count(const metrics::Counter counter, const uint64_t amount = 1) {
+            if (m_metrics) m_metrics->add(counter, amount);
+        }
+
+        void record(const metrics::Phase phase, const Clock::time_point start, const Clock::time_point end) {
+            if (m_metrics) m_metrics->record(phase, static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()));
+        }
+    };
+} // namespace net
+
+#endif // define NET_REACTOR_H
@@ -0,0 +1,67 @@
+#include "net/server.h"
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <algorithm>
+#include <exception>
+#include <iostream>
+
+#include "net/socket.h"
+
+namespace net {
+    Server::Server(const Config& config, const http::Handler& handler) :
+        m_config(config) {
+        std::size_t threads = m_config.threads;
+        if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+
+        std::shared_ptr<http::ResponseCache> cache;
+        if (m_config.cache_size > 0) cache = std::make_shared<http::ResponseCache>(m_config.cache_size);
+        std::shared_ptr<metrics::Registry> registry;
+        if (!m_config.metrics_path.empty()) registry = std::make_shared<metrics::Registry>();
+
+        // The first listener resolves an ephemeral port, the others join it through SO_REUSEPORT
+        m_port = m_config.port;
+        for (std::size_t i = 0; i < threads; ++i) {
+            const int listener = listenTcp(m_port, m_config.backlog);
+            if (i == 0) m_port = boundPort(listener);
+            m_reactors.push_back(std::make_unique<Reactor>(listener, m_config, handler, cache, registry));
+        }
+    }
+
+    Server::~Server() {
+        stop();
+        join();
+    }
+
+    void Server::start() {
+        for (std::size_t i = 0; i < m_reactors.size(); ++i) {
+            Reactor* reactor = m_reactors[i].get();
+            m_threads.emplace_back([reactor] {
+                try {
+                    reactor->run();
+                } catch (const std::exception& error) {
+                    std::cerr << "Reactor stopped: " << error.what() << '\n';
+                }
+            });
+
+            if (m_config.pin_threads) {
+                cpu_set_t cpus;
+                CPU_ZERO(&cpus);
+                CPU_SET(i % CPU_SETSIZE, &cpus);
+                pthread_setaffinity_np(m_threads.back().native_handle(), sizeof(cpus), &cpus);
+            }
+        }
+    }
+
+    void Server::stop() {
+        for (auto& reactor : m_reactors) reactor->stop();
+    }
+
+    void Server::join() {
+        for (auto& thread : m_threads) {
+            if (thread.joinable()) thread.join();
+        }
+        m_threads.clear();
+    }
+} // namespace net
@@ -0,0 +1,62 @@
+#ifndef NET_SERVER_H
+#define NET_SERVER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "http/response.h"
+#include "net/reactor.h"
+
+namespace net {
+    /**
+     * Runs one Reactor per thread, all listening on the same port. Listeners are opened in the
+     * constructor so that configuration errors surface before any thread is started.
+     */
+    class Server {
+    public:
+        /**
+         * @param[in] config     Server configuration, a port of 0 picks an ephemeral port
+         * @param[in] handler    Request handler shared (by copy) with every reactor
+         * @throws std::system_error if a listener cannot be opened
+         */
+        Server(const Config& config, const http::Handler& handler);
+        ~Server();
+
+        Server(const Server&) = delete;
+        Server& operator=(const Server&) = delete;
+
+        /**
+         * @brief Starts the reactor threads
+         */
+        void start();
+
+        /**
+         * @brief Asks every reactor to stop, safe to call from any thread
+         */
+        void stop();
+
+        /**
+         * @brief Waits for the reactor threads to return
+         */
+        void join();
+
+        uint16_t port() const {
+            return m_port;
+        }
+
+        std::size_t threads() const {
+            return m_reactors.size();
+        }
+
+    private:
+        Config m_config;
+        uint16_t m_port {0};
+        std::vector<std::unique_ptr<Reactor>> m_reactors;
+        std::vector<std::thread> m_threads;
+    };
+} // namespace net
+
+#endif // define NET_SERVER_H
@@ -0,0 +1,59 @@
+#include "net/socket.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <system_error>
+
+namespace net {
+    namespace {
+        [[noreturn]] void fail(const char* what) {
+            throw std::system_error(errno, std::generic_category(), what);
+        }
+    } // namespace
+
+    int listenTcp(const uint16_t port, const int backlog) {
+        const int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (fd < 0) fail("socket");
+
+        const int enable = 1;
+        if (setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable)) < 0 ||
+            setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &enable, sizeof(enable)) < 0) {
+            const int error = errno;
+            close(fd);
+            throw std::system_error(error, std::generic_category(), "setsockopt");
+        }
+
+        sockaddr_in address {};
+        address.sin_family      = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_ANY);
+        address.sin_port        = htons(port);
+        if (bind(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) < 0 || listen(fd, backlog) < 0) {
+            const int error = errno;
+            close(fd);
+            throw std::system_error(error, std::generic_category(), "bind");
+        }
+
+        return fd;
+    }
+
+    uint16_t boundPort(const int fd) {
+        sockaddr_in address {};
+        socklen_t length = sizeof(address);
+        if (getsockname(fd, reinterpret_cast<sockaddr*>(&address), &length) < 0) fail("getsockname");
+        return ntohs(address.sin_port);
+    }
+
+    void setNoDelay(const int fd) {
+        const int enable = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+    }
+
+    bool isLoopback(const sockaddr_in& address) {
+        return address.sin_family == AF_INET && (ntohl(address.sin_addr.s_addr) >> 24) == 127;
+    }
+} // namespace net
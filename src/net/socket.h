@@ -0,0 +1,37 @@
+#ifndef NET_SOCKET_H
+#define NET_SOCKET_H
+
+#include <netinet/in.h>
+
+#include <cstdint>
+
+namespace net {
+    /**
+     * @brief Opens a non-blocking TCP listener on every IPv4 address
+     * @param[in] port       Port to bind, 0 picks an ephemeral port
+     * @param[in] backlog    Maximum length of the pending connections queue
+     * @return The listening socket
+     * @throws std::system_error if the socket cannot be created, bound or put to listen
+     * @note SO_REUSEPORT is set so that every reactor can bind its own listener to the same
+     * port and let the kernel balance new connections across them.
+     */
+    int listenTcp(uint16_t port, int backlog);
+
+    /**
+     * @brief Port a socket is bound to
+     * @throws std::system_error if the socket name cannot be read
+     */
+    uint16_t boundPort(int fd);
+
+    /**
+     * @brief Disables Nagle's algorithm, responses are written in a single send when possible
+     */
+    void setNoDelay(int fd);
+
+    /**
+     * @brief Whether an IPv4 peer address is on the loopback network (127.0.0.0/8)
+     */
+    bool isLoopback(const sockaddr_in& address);
+} // namespace net
+
+#endif // define NET_SOCKET_H
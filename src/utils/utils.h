@@ -1,19 +1,262 @@
 #ifndef UTILS_UTILS_H
 #define UTILS_UTILS_H
 
-#include <ostream>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+
+#include <array>
+#include <cerrno>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <string_view>
 #include <type_traits>
-#include <string>
+
+#include "memory/buffer.h"
 
 namespace Utils {
-    template <typename T>
-    void presentArray(std::ostream& stream, const T& arr, const size_t size) {
-        static_assert(std::is_array<T>::value, "Cannot display elements that are not arrays");
+    /**
+     * Separator known at compile time, used by join(): Separator<';'> or Separator<',', ' '>
+     */
+    template <char... Characters>
+    struct Separator {
+        static constexpr char value[sizeof...(Characters) + 1] = {Characters..., '\0'};
+        static constexpr std::size_t size = sizeof...(Characters);
+    };
+
+    /**
+     * Elements of a contiguous range written one after the other with a separator between
+     * them. Only holds a reference, it must be formatted while the range is alive.
+     */
+    template <typename Range, typename Separator>
+    struct Joined {
+        const Range& range;
+    };
+
+    /**
+     * @brief Formats a contiguous range (C array, std::array, std::vector, string views...)
+     * with a compile-time separator, ", " by default
+     */
+    template <typename Separator = Separator<',', ' '>, typename Range>
+    constexpr Joined<Range, Separator> join(const Range& range) {
+        static_assert(std::is_pointer<decltype(std::data(range))>::value, "join() needs a contiguous range");
+        return Joined<Range, Separator> {range};
+    }
+
+    namespace detail {
+        template <typename T>
+        struct IsJoined : std::false_type {};
+
+        template <typename Range, typename Separator>
+        struct IsJoined<Joined<Range, Separator>> : std::true_type {};
+
+        //! Number of elements when the type fixes it (C arrays and std::array), 0 otherwise
+        template <typename Range>
+        struct StaticExtent : std::integral_constant<std::size_t, 0> {};
+
+        template <typename T, std::size_t N>
+        struct StaticExtent<T[N]> : std::integral_constant<std::size_t, N> {};
+
+        template <typename T, std::size_t N>
+        struct StaticExtent<std::array<T, N>> : std::integral_constant<std::size_t, N> {};
+
+        template <typename T>
+        constexpr std::size_t maxSize();
+
+        //! Type-level access to the separator of a Joined, never defined
+        template <typename Range, typename Glue>
+        Glue joinSeparator(const Joined<Range, Glue>&);
+
+        template <typename T, typename Range = std::remove_cv_t<std::remove_reference_t<decltype(std::declval<T>().range)>>>
+        constexpr std::size_t maxJoinedSize() {
+            using Element = std::remove_cv_t<std::remove_reference_t<decltype(*std::data(std::declval<Range&>()))>>;
+            using Glue    = decltype(joinSeparator(std::declval<T>()));
+            constexpr std::size_t count = StaticExtent<Range>::value;
+            if constexpr (count == 0 || maxSize<Element>() == 0) {
+                return 0;
+            } else {
+                return count * maxSize<Element>() + (count - 1) * Glue::size;
+            }
+        }
+
+        /**
+         * Most characters a value of type T can take, 0 when it depends on the value. Integers
+         * get room for a sign, floating point numbers for the shortest round-trip form.
+         */
+        template <typename T>
+        constexpr std::size_t maxSize() {
+            if constexpr (std::is_same<T, bool>::value) {
+                return 5;
+            } else if constexpr (std::is_same<T, char>::value) {
+                return 1;
+            } else if constexpr (std::is_integral<T>::value) {
+                return std::numeric_limits<T>::digits10 + 2;
+            } else if constexpr (std::is_same<T, float>::value || std::is_same<T, double>::value) {
+                return 24;
+            } else if constexpr (IsJoined<T>::value) {
+                return maxJoinedSize<T>();
+            } else {
+                return 0;
+            }
+        }
+
+        template <typename T>
+        std::size_t sizeOf(const T& value) {
+            if constexpr (maxSize<T>() != 0) {
+                return maxSize<T>();
+            } else if constexpr (IsJoined<T>::value) {
+                std::size_t total = 0;
+                for (const auto& element : value.range) total += sizeOf(element) + decltype(joinSeparator(value))::size;
+                return total;
+            } else {
+                return std::string_view(value).size();
+            }
+        }
+    } // namespace detail
 
-        stream << "[";
-        for (size_t i = 0; i < size; ++i) stream << arr[i] << (i != size - 1 ? ", " : "");
-        stream << "]\n";
+    /**
+     * Upper bound of the characters needed by a list of values whose types all have a fixed
+     * maximum (numbers, characters, and ranges of them with a static extent), usable to size
+     * a stack buffer: char line[Utils::kMaxFormattedSize<int, char, uint64_t>];
+     */
+    template <typename... Values>
+    constexpr std::size_t kMaxFormattedSize = (detail::maxSize<Values>() + ... + 0);
+
+    /**
+     * @brief Upper bound of the characters Writer::append() writes for these values
+     */
+    template <typename... Values>
+    std::size_t formattedSize(const Values&... values) {
+        return (detail::sizeOf(values) + ... + 0);
+    }
+
+    /**
+     * Unchecked output cursor: numbers go through std::to_chars, strings are copied, nothing
+     * allocates and nothing depends on the locale. The caller makes room first, with
+     * formattedSize().
+     */
+    class Writer {
+    public:
+        explicit Writer(char* out) noexcept :
+            m_cursor(out) {}
+
+        template <typename... Values>
+        Writer& append(const Values&... values) {
+            (put(values), ...);
+            return *this;
+        }
+
+        char* position() const {
+            return m_cursor;
+        }
+
+    private:
+        char* m_cursor;
+
+        template <typename T>
+        void put(const T& value) {
+            if constexpr (std::is_same<T, bool>::value) {
+                put(value ? std::string_view("true") : std::string_view("false"));
+            } else if constexpr (std::is_same<T, char>::value) {
+                *m_cursor++ = value;
+            } else if constexpr (std::is_arithmetic<T>::value) {
+                m_cursor = std::to_chars(m_cursor, m_cursor + detail::maxSize<T>(), value).ptr;
+            } else if constexpr (detail::IsJoined<T>::value) {
+                using Glue       = decltype(detail::joinSeparator(value));
+                const auto* data = std::data(value.range);
+                const auto size  = std::size(value.range);
+                for (std::size_t i = 0; i < size; ++i) {
+                    if (i != 0) put(std::string_view(Glue::value, Glue::size));
+                    put(data[i]);
+                }
+            } else {
+                const std::string_view bytes(value);
+                std::memcpy(m_cursor, bytes.data(), bytes.size());
+                m_cursor += bytes.size();
+            }
+        }
+    };
+
+    /**
+     * @brief Formats values at the end of a buffer, reserving room once for all of them
+     */
+    template <typename... Values>
+    void append(memory::Buffer& out, const Values&... values) {
+        out.reserve(formattedSize(values...));
+        char* const begin = out.tail();
+        out.commit(static_cast<std::size_t>(Writer(begin).append(values...).position() - begin));
     }
-}
+
+    /**
+     * @brief Formats values into a fixed buffer, whose size is deduced
+     * @return View over the formatted characters, empty when the buffer may be too small
+     */
+    template <std::size_t N, typename... Values>
+    std::string_view format(char (&buffer)[N], const Values&... values) {
+        if (formattedSize(values...) > N) return {};
+        return std::string_view(buffer, static_cast<std::size_t>(Writer(buffer).append(values...).position() - buffer));
+    }
+
+    /**
+     * Byte ranges sent with a single vectored write, so that a header block and a body kept
+     * in different places go out without being copied together first.
+     */
+    template <std::size_t N>
+    class Gather {
+    public:
+        void add(const std::string_view bytes) {
+            if (bytes.empty()) return;
+            m_parts[m_count].iov_base = const_cast<char*>(bytes.data());
+            m_parts[m_count].iov_len  = bytes.size();
+            ++m_count;
+            m_size += bytes.size();
+        }
+
+        std::size_t size() const {
+            return m_size;
+        }
+
+        /**
+         * @brief Writes as much as the socket accepts, with sendmsg() so that flags such as
+         * MSG_NOSIGNAL apply (writev() has none)
+         * @return Bytes written, or -1 with errno set
+         */
+        ssize_t send(const int fd, const int flags) {
+            msghdr message {};
+            message.msg_iov    = m_parts.data();
+            message.msg_iovlen = m_count;
+            ssize_t sent;
+            do {
+                sent = sendmsg(fd, &message, flags);
+            } while (sent < 0 && errno == EINTR);
+            return sent;
+        }
+
+        /**
+         * @brief Calls visitor with what follows the first skip bytes, part by part
+         */
+        template <typename Visitor>
+        void forEachAfter(std::size_t skip, Visitor&& visitor) const {
+            for (std::size_t i = 0; i < m_count; ++i) {
+                const std::string_view part(static_cast<const char*>(m_parts[i].iov_base), m_parts[i].iov_len);
+                if (skip >= part.size()) {
+                    skip -= part.size();
+                    continue;
+                }
+                visitor(part.substr(skip));
+                skip = 0;
+            }
+        }
+
+    private:
+        std::array<iovec, N> m_parts {};
+        std::size_t m_count {0};
+        std::size_t m_size {0};
+    };
+} // namespace Utils
 
 #endif // define UTILS_UTILS_H
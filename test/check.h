@@ -0,0 +1,34 @@
+#ifndef TEST_CHECK_H
+#define TEST_CHECK_H
+
+#include <cstdio>
+
+namespace test {
+    //! Failed checks so far, main() turns a non-zero count into the exit status
+    inline int& failures() {
+        static int count = 0;
+        return count;
+    }
+
+    //! Kernels of every available instruction set agree with the scalar ones
+    void scanKernels();
+
+    //! A request parses the same whatever byte offset it is split at
+    void parserSplits();
+} // namespace test
+
+/**
+ * Reports a failed condition with its location and keeps going, so that one run lists every
+ * failure. Tests are built with NDEBUG like the server, assert() would check nothing.
+ */
+#define SAGAN_CHECK(condition, ...)                                                  \
+    do {                                                                             \
+        if (!(condition)) {                                                          \
+            ++test::failures();                                                      \
+            std::fprintf(stderr, "%s:%d: check failed: %s: ", __FILE__, __LINE__, #condition); \
+            std::fprintf(stderr, __VA_ARGS__);                                       \
+            std::fputc('\n', stderr);                                                \
+        }                                                                            \
+    } while (false)
+
+#endif // define TEST_CHECK_H
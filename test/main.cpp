@@ -0,0 +1,19 @@
+#include <cstdio>
+
+#include "check.h"
+
+/**
+ * Checks of the code that is easiest to get subtly wrong: the SIMD scan kernels against
+ * their scalar reference, and the incremental parser against arbitrary read boundaries.
+ */
+int main() {
+    test::scanKernels();
+    test::parserSplits();
+
+    if (test::failures() > 0) {
+        std::fprintf(stderr, "%d checks failed\n", test::failures());
+        return 1;
+    }
+    std::printf("All checks passed\n");
+    return 0;
+}
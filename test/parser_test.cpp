@@ -0,0 +1,75 @@
+#include <cstdio>
+#include <string>
+#include <string_view>
+
+#include "check.h"
+#include "http/request_parser.h"
+
+namespace test {
+    namespace {
+        constexpr std::string_view kRequest =
+            "POST /api/v1/items?page=2&sort=name HTTP/1.1\r\n"
+            "Host: example.com\r\n"
+            "User-Agent: Mozilla/5.0 (X11; Linux x86_64)\r\n"
+            "Accept: text/html,application/xhtml+xml;q=0.9,*/*;q=0.8\r\n"
+            "Accept-Encoding: gzip, deflate\r\n"
+            "X-Request-Id:\t0f8c7b6a-5d4e \r\n"
+            "Content-Type: application/json\r\n"
+            "Content-Length: 13\r\n"
+            "\r\n"
+            "{\"page\": \"2\"}";
+
+        bool same(const http::Request& lhs, const http::Request& rhs) {
+            if (lhs.method != rhs.method || lhs.method_name != rhs.method_name || lhs.target != rhs.target) return false;
+            if (lhs.version_minor != rhs.version_minor || lhs.field_count != rhs.field_count) return false;
+            for (std::size_t i = 0; i < lhs.field_count; ++i) {
+                const http::Header& left  = lhs.fields[i];
+                const http::Header& right = rhs.fields[i];
+                if (left.id != right.id || left.name != right.name || left.value != right.value) return false;
+            }
+            return true;
+        }
+    } // namespace
+
+    void parserSplits() {
+        http::RequestParser parser;
+        http::Request expected;
+        const std::string whole(kRequest);
+        SAGAN_CHECK(parser.parse(whole, expected) == http::ParseResult::complete, "the whole request does not parse");
+        const std::size_t head = parser.consumed();
+        SAGAN_CHECK(head == kRequest.find("\r\n\r\n") + 4, "consumed %zu bytes", head);
+        SAGAN_CHECK(expected.field_count == 7 && expected.fields[4].id == http::headers::Id::unknown, "%zu fields", expected.field_count);
+        SAGAN_CHECK(expected.fields[4].value == "0f8c7b6a-5d4e", "value not trimmed");
+        SAGAN_CHECK(expected.header(http::headers::Id::user_agent) == "Mozilla/5.0 (X11; Linux x86_64)", "user-agent not found");
+
+        // The first read ends at split; the second gets a copy in a new buffer, as when the
+        // connection grows its input, so the parser may only have kept offsets
+        for (std::size_t split = 0; split <= kRequest.size(); ++split) {
+            parser.reset();
+            http::Request request;
+            const std::string first(kRequest.substr(0, split));
+            const std::string second(kRequest);
+            const http::ParseResult partial = parser.parse(first, request);
+            if (split < head) {
+                SAGAN_CHECK(partial == http::ParseResult::incomplete, "split at %zu: the partial head did not ask for more", split);
+                SAGAN_CHECK(parser.parse(second, request) == http::ParseResult::complete, "split at %zu: incomplete after the rest", split);
+            } else {
+                SAGAN_CHECK(partial == http::ParseResult::complete, "split at %zu: the complete head did not parse", split);
+            }
+            SAGAN_CHECK(parser.consumed() == head, "split at %zu: consumed %zu bytes", split, parser.consumed());
+            SAGAN_CHECK(same(request, expected), "split at %zu: fields differ", split);
+        }
+
+        // One byte per read, the worst case for resuming
+        parser.reset();
+        http::Request request;
+        http::ParseResult result = http::ParseResult::incomplete;
+        std::size_t size         = 0;
+        while (result == http::ParseResult::incomplete && size < kRequest.size()) result = parser.parse(kRequest.substr(0, ++size), request);
+        SAGAN_CHECK(result == http::ParseResult::complete && size == head, "byte by byte: result %d after %zu bytes",
+                    static_cast<int>(result), size);
+        SAGAN_CHECK(same(request, expected), "byte by byte: fields differ");
+
+        std::printf("parser: request split at each of %zu offsets parses the same\n", kRequest.size() + 1);
+    }
+} // namespace test
@@ -0,0 +1,90 @@
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <string_view>
+
+#include "check.h"
+#include "http/scan.h"
+
+namespace test {
+    namespace {
+        constexpr int kRounds            = 20000;
+        constexpr std::size_t kMaxLength = 160; // Several vectors, plus a scalar tail
+        constexpr std::string_view kTokens =
+            "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789!#$%&'*+-.^_`|~";
+
+        const char* isaName(const http::scan::Isa isa) {
+            switch (isa) {
+                case http::scan::Isa::avx2: return "avx2";
+                case http::scan::Isa::sse42: return "sse4.2";
+                default: return "scalar";
+            }
+        }
+
+        /**
+         * Uniform random bytes rarely leave a run long enough to need the vector loop, so most
+         * inputs are tokens with the odd byte from the whole range
+         */
+        std::string randomBytes(std::mt19937& random, const std::size_t length) {
+            std::string bytes(length, '\0');
+            const bool uniform = random() % 4 == 0;
+            for (char& byte : bytes) {
+                if (uniform || random() % 64 == 0) {
+                    byte = static_cast<char>(random() & 0xff);
+                } else {
+                    byte = kTokens[random() % kTokens.size()];
+                }
+            }
+            return bytes;
+        }
+
+        void compare(const char* kernel, const http::scan::Isa isa, const http::scan::Kernel tested,
+                     const http::scan::Kernel reference, const std::string& bytes, const std::size_t offset) {
+            const char* begin    = bytes.data() + offset;
+            const char* end      = bytes.data() + bytes.size();
+            const char* expected = reference(begin, end);
+            const char* actual   = tested(begin, end);
+            SAGAN_CHECK(actual == expected, "%s %s on %zu bytes: found %td, expected %td", isaName(isa), kernel,
+                        bytes.size() - offset, actual - begin, expected - begin);
+        }
+    } // namespace
+
+    void scanKernels() {
+        http::scan::Kernels scalar;
+        http::scan::kernelsFor(http::scan::Isa::scalar, scalar);
+
+        std::mt19937 random(20190501);
+        for (const http::scan::Isa isa : {http::scan::Isa::sse42, http::scan::Isa::avx2}) {
+            http::scan::Kernels kernels;
+            if (!http::scan::kernelsFor(isa, kernels)) {
+                std::printf("scan: %s not supported, skipped\n", isaName(isa));
+                continue;
+            }
+            for (int round = 0; round < kRounds; ++round) {
+                // Random starting offsets take the unaligned loads through every alignment
+                const std::string bytes  = randomBytes(random, random() % kMaxLength);
+                const std::size_t offset = bytes.empty() ? 0 : random() % bytes.size();
+                compare("findLineEnd", isa, kernels.line_end, scalar.line_end, bytes, offset);
+                compare("findSpaceOrControl", isa, kernels.space_or_control, scalar.space_or_control, bytes, offset);
+                compare("findNonToken", isa, kernels.non_token, scalar.non_token, bytes, offset);
+            }
+            std::printf("scan: %s kernels match the scalar ones on %d inputs\n", isaName(isa), kRounds);
+        }
+
+        // Every single byte value, at each position of a vector and in the scalar tail
+        for (const http::scan::Isa isa : {http::scan::Isa::sse42, http::scan::Isa::avx2}) {
+            http::scan::Kernels kernels;
+            if (!http::scan::kernelsFor(isa, kernels)) continue;
+            for (int value = 0; value < 256; ++value) {
+                for (std::size_t position = 0; position < 40; ++position) {
+                    std::string bytes(40, 'a');
+                    bytes[position] = static_cast<char>(value);
+                    compare("findLineEnd", isa, kernels.line_end, scalar.line_end, bytes, 0);
+                    compare("findSpaceOrControl", isa, kernels.space_or_control, scalar.space_or_control, bytes, 0);
+                    compare("findNonToken", isa, kernels.non_token, scalar.non_token, bytes, 0);
+                }
+            }
+        }
+    }
+} // namespace test